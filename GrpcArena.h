@@ -0,0 +1,30 @@
+#pragma once
+
+#include <grpcpp/support/message_allocator.h>
+#include <google/protobuf/arena.h>
+
+/***
+* Arena allocation for callback api request/reply pairs
+* Both messages live in one arena that is dropped in a single free once the rpc is done
+*/
+
+template<typename RequestT, typename ResponseT> class GrpcArenaMessageHolder : public grpc::MessageHolder<RequestT, ResponseT>
+{
+public:
+	GrpcArenaMessageHolder()
+	{
+		this->set_request(google::protobuf::Arena::CreateMessage<RequestT>(&m_arena));
+		this->set_response(google::protobuf::Arena::CreateMessage<ResponseT>(&m_arena));
+	}
+
+	void Release() override { delete this; }
+
+private:
+	google::protobuf::Arena m_arena;
+};
+
+template<typename RequestT, typename ResponseT> class GrpcArenaAllocator : public grpc::MessageAllocator<RequestT, ResponseT>
+{
+public:
+	grpc::MessageHolder<RequestT, ResponseT> *AllocateMessages() override { return new GrpcArenaMessageHolder<RequestT, ResponseT>(); }
+};
@@ -1,42 +1,145 @@
 #include "GrpcBrowser.h"
+#include "JsonWriter.h"
+#include "PayloadChunks.h"
 #include "SlBrowser.h"
 #include "WindowsFunctions.h"
 
 #include <filesystem>
 
+#include <QApplication>
+
 /***
-* Server
-* Receiving messages from the plugin
+* Handlers
+* Shared by the unary server calls and the js stream
+*	Called on grpc threads, the work is posted to the thread that owns it and they return immediately
 */
 
-class grpc_proxy_objImpl final : public grpc_proxy_obj::Service
+class GrpcBrowserTask : public CefTask
+{
+public:
+	std::function<void()> task;
+	inline GrpcBrowserTask(std::function<void()> task_) : task(task_) {}
+	void Execute() override { task(); }
+	IMPLEMENT_REFCOUNTING(GrpcBrowserTask);
+};
+
+static void queueCefTask(std::function<void()> task)
 {
-	grpc::Status com_grpc_js_executeCallback(grpc::ServerContext *context, const grpc_js_api_ExecuteCallback *request, grpc_js_api_Reply *response) override
+	CefPostTask(TID_UI, CefRefPtr<GrpcBrowserTask>(new GrpcBrowserTask(task)));
+}
+
+// Cef's ui thread. Frames held by the plugin can arrive before CreateCefBrowser has run, there's no page for them yet then
+static CefRefPtr<CefBrowser> getKnownBrowser(const int browserId)
+{
+	CefRefPtr<BrowserClient> client = SlBrowser::instance().browserClient;
+	return client != nullptr ? client->GetKnownBrowser(browserId) : nullptr;
+}
+
+static CefRefPtr<CefBrowser> getMostRecentRenderKnown()
+{
+	CefRefPtr<BrowserClient> client = SlBrowser::instance().browserClient;
+	return client != nullptr ? client->GetMostRecentRenderKnown() : nullptr;
+}
+
+static void onApiReply(const grpc_js_api_Reply &reply)
+{
+	// Nothing on the browser is waiting for it
+	if (reply.funcid() <= 0)
+		return;
+
+	std::string jsonStr;
+
+	if (reply.shmlength() == 0)
+	{
+		jsonStr = reply.jsonstr();
+	}
+	else if (!GrpcBrowser::instance().readReplyPayload(reply, jsonStr))
 	{
+		printf("com_grpc_js_api reply %d was not found in the payload ring\n", reply.funcid());
+		jsonStr = JsonWriter::object(JsonKeys::kError, "Result was lost");
+	}
+
+	queueCefTask([funcId = reply.funcid(), browserId = reply.browserid(), jsonStr = std::move(jsonStr)]() {
 		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("executeCallback");
 		CefRefPtr<CefListValue> execute_args = msg->GetArgumentList();
-		execute_args->SetInt(0, request->funcid());
-		execute_args->SetString(1, request->jsonstr());
+		execute_args->SetInt(0, funcId);
+		execute_args->SetString(1, jsonStr);
 
-		if (auto ptr = SlBrowser::instance().browserClient->PopCallback(request->funcid()))
+		if (auto ptr = getKnownBrowser(browserId))
 		{
 			SendBrowserProcessMessage(ptr, PID_RENDERER, msg);
 		}
 		else
 		{
-			printf("com_grpc_js_executeCallback failed to find browser for function");
+			printf("com_grpc_js_api reply failed to find browser %d for function\n", browserId);
 		}
+	});
+}
 
-		return grpc::Status::OK;
-	}
+static void onApiChunk(const grpc_js_api_Chunk &chunk)
+{
+	if (chunk.funcid() <= 0)
+		return;
 
-	grpc::Status com_grpc_run_javascriptOnBrowser(grpc::ServerContext *context, const grpc_run_javascriptOnBrowser *request, grpc_empty_Reply *response) override
-	{
+	std::string data;
+	const bool ok = !chunk.lost() && PayloadChunks::decompress(chunk.data(), chunk.rawlength(), data);
+
+	if (chunk.lost())
+		printf("com_grpc_js_api reply %d was lost after %d chunks\n", chunk.funcid(), int(chunk.seq()));
+	else if (!ok)
+		printf("com_grpc_js_api chunk %d of reply %d failed to inflate\n", int(chunk.seq()), chunk.funcid());
+
+	// Forwarded as it comes, the renderer puts the result back together. Raw bytes, a chunk can end inside a utf-8 sequence
+	queueCefTask([funcId = chunk.funcid(), browserId = chunk.browserid(), last = chunk.last(), ok, data = std::move(data)]() {
+		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("executeCallbackChunk");
+		CefRefPtr<CefListValue> execute_args = msg->GetArgumentList();
+		execute_args->SetInt(0, funcId);
+		execute_args->SetBinary(1, CefBinaryValue::Create(data.data(), data.size()));
+		execute_args->SetBool(2, last);
+		execute_args->SetBool(3, ok);
+
+		if (auto ptr = getKnownBrowser(browserId))
+		{
+			SendBrowserProcessMessage(ptr, PID_RENDERER, msg);
+		}
+		else
+		{
+			printf("com_grpc_js_api chunk failed to find browser %d for function\n", browserId);
+		}
+	});
+}
+
+static void onApiEvents(const grpc_js_api_Events &events)
+{
+	if (events.funcid() <= 0)
+		return;
+
+	// Same callback for every frame, the renderer keeps it around for the page's subscription
+	queueCefTask([funcId = events.funcid(), browserId = events.browserid(), jsonStr = events.jsonstr()]() {
+		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("executeEventCallback");
+		CefRefPtr<CefListValue> execute_args = msg->GetArgumentList();
+		execute_args->SetInt(0, funcId);
+		execute_args->SetString(1, jsonStr);
+
+		if (auto ptr = getKnownBrowser(browserId))
+		{
+			SendBrowserProcessMessage(ptr, PID_RENDERER, msg);
+		}
+		else
+		{
+			printf("com_grpc_js_stream events failed to find browser %d\n", browserId);
+		}
+	});
+}
+
+static void onRunJavascript(const grpc_run_javascriptOnBrowser &request)
+{
+	queueCefTask([str = request.str()]() {
 		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("executeJavascript");
 		CefRefPtr<CefListValue> execute_args = msg->GetArgumentList();
-		execute_args->SetString(0, request->str());
+		execute_args->SetString(0, str);
 
-		if (auto ptr = SlBrowser::instance().browserClient->GetMostRecentRenderKnown())
+		if (auto ptr = getMostRecentRenderKnown())
 		{
 			SendBrowserProcessMessage(ptr, PID_RENDERER, msg);
 		}
@@ -44,40 +147,71 @@ class grpc_proxy_objImpl final : public grpc_proxy_obj::Service
 		{
 			printf("com_grpc_run_javascriptOnBrowser failed to a suitable browser for function");
 		}
+	});
+}
 
-		return grpc::Status::OK;
-	}
-
-	grpc::Status com_grpc_window_toggleVisibility(grpc::ServerContext *context, const grpc_window_toggleVisibility *request, grpc_empty_Reply *response) override
+static void toggleVisibility()
+{
+	// If hidden
+	if (SlBrowser::instance().m_widget->isHidden())
 	{
-		// If hidden
-		if (SlBrowser::instance().m_widget->isHidden())
+		// Main page isn't loading and it also failed
+		if (!SlBrowser::instance().getMainLoadingInProgress() && !SlBrowser::instance().getMainPageSuccess())
 		{
-			// Main page isn't loading and it also failed
-			if (!SlBrowser::instance().getMainLoadingInProgress() && !SlBrowser::instance().getMainPageSuccess())
+			// Attempt load default URL again
+			SlBrowser::instance().setMainLoadingInProgress(true);
+
+			if (auto browser = SlBrowser::instance().m_browser)
 			{
-				// Attempt load default URL again
-				SlBrowser::instance().setMainLoadingInProgress(true);
-
-				if (auto browser = SlBrowser::instance().m_browser)
-				{
-					if (auto frame = SlBrowser::instance().m_browser->GetMainFrame())
-						frame->LoadURL(SlBrowser::getDefaultUrl());
-				}
+				if (auto frame = SlBrowser::instance().m_browser->GetMainFrame())
+					frame->LoadURL(SlBrowser::getDefaultUrl());
 			}
-
-			// Swap hidden state
-			SlBrowser::instance().m_widget->setHidden(!SlBrowser::instance().m_widget->isHidden());
 		}
 
-		if (!SlBrowser::instance().m_widget->isHidden())
-		{
-			HWND hwnd = HWND(SlBrowser::instance().m_widget->winId());
-			WindowsFunctions::ForceForegroundWindow(hwnd);
-		}
+		// Swap hidden state
+		SlBrowser::instance().m_widget->setHidden(!SlBrowser::instance().m_widget->isHidden());
+	}
 
-		SlBrowser::instance().saveHiddenState(SlBrowser::instance().m_widget->isHidden());
-		return grpc::Status::OK;
+	if (!SlBrowser::instance().m_widget->isHidden())
+	{
+		HWND hwnd = HWND(SlBrowser::instance().m_widget->winId());
+		WindowsFunctions::ForceForegroundWindow(hwnd);
+	}
+
+	SlBrowser::instance().saveHiddenState(SlBrowser::instance().m_widget->isHidden());
+}
+
+static void onToggleVisibility()
+{
+	// The widget belongs to the Qt thread
+	if (qApp != nullptr)
+		QMetaObject::invokeMethod(qApp, &toggleVisibility, Qt::QueuedConnection);
+}
+
+/***
+* Server
+* Receiving messages from the plugin
+*/
+
+class grpc_proxy_objImpl final : public grpc_proxy_obj::CallbackService
+{
+	grpc::ServerUnaryReactor *com_grpc_run_javascriptOnBrowser(grpc::CallbackServerContext *context, const grpc_run_javascriptOnBrowser *request, grpc_empty_Reply *response) override
+	{
+		onRunJavascript(*request);
+		return finishNow(context);
+	}
+
+	grpc::ServerUnaryReactor *com_grpc_window_toggleVisibility(grpc::CallbackServerContext *context, const grpc_window_toggleVisibility *request, grpc_empty_Reply *response) override
+	{
+		onToggleVisibility();
+		return finishNow(context);
+	}
+
+	static grpc::ServerUnaryReactor *finishNow(grpc::CallbackServerContext *context)
+	{
+		auto reactor = context->DefaultReactor();
+		reactor->Finish(grpc::Status::OK);
+		return reactor;
 	}
 };
 
@@ -86,27 +220,209 @@ class grpc_proxy_objImpl final : public grpc_proxy_obj::Service
 * Sending messages to the plugin
 */
 
-grpc_proxy_objClient::grpc_proxy_objClient(std::shared_ptr<grpc::Channel> channel) : stub_(grpc_plugin_obj::NewStub(channel))
+grpc_proxy_objClient::grpc_proxy_objClient(std::shared_ptr<grpc::Channel> channel) : m_channel(channel), stub_(grpc_plugin_obj::NewStub(channel))
+{
+	// Doesn't wait, cef and the widget come up while this connects. Calls made before then are held
+	m_connectionThread = std::thread(&grpc_proxy_objClient::connectionThread, this);
+	m_writerThread = std::thread(&grpc_proxy_objClient::writerThread, this);
+}
+
+grpc_proxy_objClient::~grpc_proxy_objClient()
 {
-	m_connected = channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(3));
+	{
+		std::lock_guard<std::mutex> grd(m_streamMtx);
+		m_stopping = true;
+
+		if (m_streamContext != nullptr)
+			m_streamContext->TryCancel();
+	}
+
+	m_stoppingCv.notify_all();
+	m_writeCv.notify_all();
+
+	if (m_writerThread.joinable())
+		m_writerThread.join();
+
+	if (m_connectionThread.joinable())
+		m_connectionThread.join();
+}
+
+bool grpc_proxy_objClient::send_js_api(const grpc_js_api_Request &request)
+{
+	// Cef's ui thread, only queues. The writer thread does the blocking stream write
+	std::lock_guard<std::mutex> grd(m_streamMtx);
+
+	if (m_pending.size() >= GrpcReconnect::kMaxPending)
+	{
+		printf("grpc_proxy_objClient: plugin isn't taking calls and %d are waiting, dropping %s\n", int(m_pending.size()), request.funcname().c_str());
+		return false;
+	}
+
+	m_pending.push_back(request);
+	m_writeCv.notify_one();
+	return true;
+}
+
+void grpc_proxy_objClient::send_js_cancel(const int browserId, const uint32_t navigation, const bool closed)
+{
+	struct PendingCall
+	{
+		grpc::ClientContext context;
+		grpc_js_api_Cancel request;
+		grpc_empty_Reply reply;
+	};
+
+	// Nothing to cancel if the link is down, the queued calls haven't reached the plugin
+	if (!m_connected)
+		return;
+
+	auto call = std::make_shared<PendingCall>();
+	call->context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(3));
+	call->request.set_browserid(browserId);
+	call->request.set_navigation(navigation);
+	call->request.set_closed(closed);
+
+	stub_->async()->com_grpc_js_cancel(&call->context, &call->request, &call->reply, [call](grpc::Status) {});
 }
 
-bool grpc_proxy_objClient::send_js_api(const std::string &funcName, const std::string &params)
+void grpc_proxy_objClient::connectionThread()
 {
-	grpc_js_api_Request request;
-	request.set_funcname(funcName);
-	request.set_params(params);
+	GrpcReconnect::Backoff backoff;
+
+	while (!m_stopping)
+	{
+		// The channel redials on its own, this only has to notice when it's back
+		if (!m_channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::milliseconds(250)))
+			continue;
+
+		bool linked = openStream();
+
+		if (linked && !sendReady())
+		{
+			closeStream();
+			linked = false;
+		}
+
+		if (!linked)
+		{
+			std::unique_lock<std::mutex> lock(m_streamMtx);
+			m_stoppingCv.wait_for(lock, backoff.next(), [this]() { return m_stopping.load(); });
+			continue;
+		}
+
+		backoff.reset();
+		readStream();
+		closeStream();
 
-	grpc_js_api_Reply reply;
+		if (!m_stopping)
+			printf("grpc_proxy_objClient: js stream to the plugin closed, reconnecting\n");
+	}
+}
+
+bool grpc_proxy_objClient::sendReady()
+{
+	// Once, after the first stream is open so the plugin can write to us as soon as it hears from us
+	if (m_readySent)
+		return true;
+
+	grpc_ready_Request request;
+	request.set_pid(GetCurrentProcessId());
+
+	grpc_empty_Reply reply;
 	grpc::ClientContext context;
-	grpc::Status status = stub_->com_grpc_js_api(&context, request, &reply);
+	context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(3));
 
-	if (!status.ok())
-		return m_connected = false;
+	m_readySent = stub_->com_grpc_ready(&context, request, &reply).ok();
+	return m_readySent;
+}
 
+bool grpc_proxy_objClient::openStream()
+{
+	std::lock_guard<std::mutex> grd(m_streamMtx);
+
+	if (m_stopping)
+		return false;
+
+	m_streamContext = std::make_unique<grpc::ClientContext>();
+	m_stream = stub_->com_grpc_js_stream(m_streamContext.get());
+
+	// The writer replays what's held, in the order the calls were made
+	m_connected = true;
+	m_writeCv.notify_one();
 	return true;
 }
 
+void grpc_proxy_objClient::closeStream()
+{
+	std::unique_lock<std::mutex> lock(m_streamMtx);
+	m_connected = false;
+
+	// Cancelling unblocks a write in progress, the stream can go once the writer is out of it
+	m_streamContext->TryCancel();
+	m_writeCv.wait(lock, [this]() { return !m_writing; });
+
+	m_stream->Finish();
+	m_stream.reset();
+	m_streamContext.reset();
+}
+
+void grpc_proxy_objClient::writerThread()
+{
+	std::unique_lock<std::mutex> lock(m_streamMtx);
+
+	while (true)
+	{
+		m_writeCv.wait(lock, [this]() { return m_stopping || (m_connected && !m_pending.empty()); });
+
+		if (m_stopping)
+			return;
+
+		grpc_js_api_Request request = std::move(m_pending.front());
+		m_pending.pop_front();
+
+		// Blocks while the plugin isn't reading, nothing else waits on it. closeStream doesn't free the stream under a write
+		grpc::ClientReaderWriter<grpc_js_api_Request, grpc_stream_Frame> *stream = m_stream.get();
+		m_writing = true;
+		lock.unlock();
+
+		const bool written = stream->Write(request);
+
+		lock.lock();
+		m_writing = false;
+		m_writeCv.notify_all();
+
+		if (!written)
+		{
+			// Goes again first on the next stream, dropping the reader out so that one is opened
+			m_pending.push_front(std::move(request));
+
+			if (m_connected)
+			{
+				m_connected = false;
+				m_streamContext->TryCancel();
+			}
+		}
+	}
+}
+
+void grpc_proxy_objClient::readStream()
+{
+	grpc_stream_Frame frame;
+
+	while (m_stream->Read(&frame))
+	{
+		switch (frame.payload_case())
+		{
+		case grpc_stream_Frame::kReply: onApiReply(frame.reply()); break;
+		case grpc_stream_Frame::kChunk: onApiChunk(frame.chunk()); break;
+		case grpc_stream_Frame::kEvents: onApiEvents(frame.events()); break;
+		case grpc_stream_Frame::kJavascript: onRunJavascript(frame.javascript()); break;
+		case grpc_stream_Frame::kTogglevisibility: onToggleVisibility(); break;
+		default: break;
+		}
+	}
+}
+
 // Grpc
 //
 
@@ -114,21 +430,26 @@ GrpcBrowser::GrpcBrowser() {}
 
 GrpcBrowser::~GrpcBrowser() {}
 
-bool GrpcBrowser::startServer(int32_t listenPort)
+bool GrpcBrowser::startServer(const std::string &listenAddress)
 {
 	// Don't repeat
-	if (m_listenPort != 0)
+	if (!m_listenAddress.empty())
 		return false;
 
-	m_listenPort = listenPort;
+	m_listenAddress = listenAddress;
+
+	// Left over from a crash, binding would fail otherwise
+	GrpcTransport::removeUnixSocket(m_listenAddress);
 
 	grpc::EnableDefaultHealthCheckService(true);
 	grpc::reflection::InitProtoReflectionServerBuilderPlugin();
 
 	m_builder = std::make_unique<grpc::ServerBuilder>();
-	m_builder->AddListeningPort(std::string("localhost:") + std::to_string(m_listenPort), grpc::InsecureServerCredentials());
+	m_builder->AddListeningPort(m_listenAddress, grpc::InsecureServerCredentials());
 
 	m_serverObj = std::make_unique<grpc_proxy_objImpl>();
+	m_serverObj->SetMessageAllocatorFor_com_grpc_run_javascriptOnBrowser(&m_runJavascriptAllocator);
+	m_serverObj->SetMessageAllocatorFor_com_grpc_window_toggleVisibility(&m_toggleVisibilityAllocator);
 	m_builder->RegisterService(m_serverObj.get());
 
 	m_server = m_builder->BuildAndStart();
@@ -136,10 +457,23 @@ bool GrpcBrowser::startServer(int32_t listenPort)
 	return m_server != nullptr;
 }
 
-bool GrpcBrowser::connectToClient(int32_t portNumber)
+bool GrpcBrowser::connectToClient(const std::string &address)
 {
-	m_clientObj = std::make_unique<grpc_proxy_objClient>(grpc::CreateChannel("localhost:" + std::to_string(portNumber), grpc::InsecureChannelCredentials()));
+	m_clientObj = std::make_unique<grpc_proxy_objClient>(GrpcReconnect::createChannel(address));
 	return m_clientObj != nullptr;
 }
 
-void GrpcBrowser::stop() {}
+bool GrpcBrowser::mapPayloadRing(const uint32_t ownerPid)
+{
+	return m_payloadRing.open(ownerPid);
+}
+
+bool GrpcBrowser::readReplyPayload(const grpc_js_api_Reply &reply, std::string &out_jsonStr)
+{
+	return m_payloadRing.read(reply.shmoffset(), reply.shmlength(), out_jsonStr);
+}
+
+void GrpcBrowser::stop()
+{
+	m_payloadRing.close();
+}
@@ -1,8 +1,16 @@
 #pragma once
 
 #include "sl_browser_api.grpc.pb.h"
+#include "GrpcArena.h"
+#include "GrpcReconnect.h"
+#include "GrpcTransport.h"
+#include "SharedPayloadRing.h"
 
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
 #include <grpcpp/grpcpp.h>
@@ -12,13 +20,42 @@ class grpc_proxy_objClient
 {
 public:
 	grpc_proxy_objClient(std::shared_ptr<grpc::Channel> channel);
+	~grpc_proxy_objClient();
 
-	bool send_js_api(const std::string &funcName, const std::string &params);
+	// Queued for the writer thread and held while the link is down, false only once too much is waiting
+	bool send_js_api(const grpc_js_api_Request &request);
+
+	// Fire and forget, the plugin drops what the browser queued before 'navigation', or everything once it's 'closed'
+	void send_js_cancel(const int browserId, const uint32_t navigation, const bool closed);
 
 	std::atomic<bool> m_connected{false};
 
 private:
+	// Keeps the js stream open for the lifetime of the client, reopening it whenever it breaks
+	void connectionThread();
+	// Only thread that writes to the js stream, send_js_api never blocks on it
+	void writerThread();
+	bool sendReady();
+	bool openStream();
+	void readStream();
+	void closeStream();
+
+	std::shared_ptr<grpc::Channel> m_channel;
 	std::unique_ptr<grpc_plugin_obj::Stub> stub_;
+
+	// A context can't be reused, each stream gets its own
+	std::unique_ptr<grpc::ClientContext> m_streamContext;
+	std::unique_ptr<grpc::ClientReaderWriter<grpc_js_api_Request, grpc_stream_Frame>> m_stream;
+	std::deque<grpc_js_api_Request> m_pending;
+	std::mutex m_streamMtx;
+	std::condition_variable m_writeCv;
+	bool m_writing = false;
+
+	bool m_readySent = false;
+	std::atomic<bool> m_stopping{false};
+	std::condition_variable m_stoppingCv;
+	std::thread m_connectionThread;
+	std::thread m_writerThread;
 };
 
 class GrpcBrowser
@@ -30,22 +67,31 @@ public:
 		return a;
 	}
 
-	bool connectToClient(int32_t port);
-	bool startServer(int32_t port);
+	// Addresses come from GrpcTransport, either unix: or localhost:<port>
+	bool connectToClient(const std::string &address);
+	bool startServer(const std::string &address);
+	bool mapPayloadRing(const uint32_t ownerPid);
 
 	void stop();
 
+	// Stream reader thread only, the ring has a single consumer
+	bool readReplyPayload(const grpc_js_api_Reply &reply, std::string &out_jsonStr);
+
 	auto *getClient() { return m_clientObj.get(); }
 
 private:
 	GrpcBrowser();
 	~GrpcBrowser();
 
-	int32_t m_listenPort{0};
+	std::string m_listenAddress;
 
 	std::wstring m_modulePath;
 	std::unique_ptr<grpc::Server> m_server;
 	std::unique_ptr<grpc::ServerBuilder> m_builder;
-	std::unique_ptr<grpc_proxy_obj::Service> m_serverObj;
+	std::unique_ptr<grpc_proxy_obj::CallbackService> m_serverObj;
+	GrpcArenaAllocator<grpc_run_javascriptOnBrowser, grpc_empty_Reply> m_runJavascriptAllocator;
+	GrpcArenaAllocator<grpc_window_toggleVisibility, grpc_empty_Reply> m_toggleVisibilityAllocator;
 	std::unique_ptr<grpc_proxy_objClient> m_clientObj;
+
+	SharedPayloadRing m_payloadRing;
 };
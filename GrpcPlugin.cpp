@@ -1,21 +1,178 @@
 #include "GrpcPlugin.h"
 #include "JavascriptApi.h"
+#include "ObsEventChannel.h"
 #include "PluginJsHandler.h"
 
+#include <algorithm>
+#include <deque>
 #include <filesystem>
 
 /***
 * Server
 * Receiving messages from the browser
+*	Callback api, handlers only queue work for the js handler thread and return, no grpc thread is held while it runs
 */
 
-class grpc_plugin_objImpl final : public grpc_plugin_obj::Service
+class grpc_plugin_objStream final : public grpc::ServerBidiReactor<grpc_js_api_Request, grpc_stream_Frame>
 {
-	grpc::Status com_grpc_js_api(grpc::ServerContext *context, const grpc_js_api_Request *request, grpc_js_api_Reply *response) override
+public:
+	grpc_plugin_objStream()
 	{
-		PluginJsHandler::instance().pushApiRequest(request->funcname(), request->params());
-		return grpc::Status::OK;
+		GrpcPlugin::instance().attachStream(this);
+		StartRead(&m_request);
 	}
+
+	// Any thread, frames go out in the order they were queued with one write in flight at a time
+	bool queueFrame(const grpc_stream_Frame &frame)
+	{
+		const grpc_stream_Frame *next = nullptr;
+
+		{
+			std::lock_guard<std::mutex> grd(m_writeMtx);
+
+			if (m_closing)
+				return false;
+
+			m_writeQueue.push_back(frame);
+
+			if (!m_writeInFlight)
+			{
+				m_writeInFlight = true;
+				next = &m_writeQueue.front();
+			}
+		}
+
+		// Outside the lock, grpc may run OnWriteDone inline. Queued frames keep their address until popped
+		if (next != nullptr)
+			StartWrite(next);
+
+		return true;
+	}
+
+	void OnReadDone(bool ok) override
+	{
+		if (ok)
+		{
+			PluginJsHandler::instance().pushApiRequest(m_request, [browserId = m_request.browserid()](const int funcId, const std::string &jsonReturn) {
+				// Nothing on the browser is waiting for it
+				if (funcId <= 0)
+					return;
+
+				if (!GrpcPlugin::instance().writeReply(funcId, browserId, jsonReturn))
+					blog(LOG_ERROR, "grpc_plugin_objStream: js stream closed and reply %d could not be held", funcId);
+			});
+
+			StartRead(&m_request);
+			return;
+		}
+
+		// Proxy closed its side, anything sent from now on falls back to unary calls
+		GrpcPlugin::instance().detachStream(this);
+
+		bool finishNow = false;
+
+		{
+			std::lock_guard<std::mutex> grd(m_writeMtx);
+			m_closing = true;
+			finishNow = !m_writeInFlight && claimFinish();
+		}
+
+		if (finishNow)
+			Finish(grpc::Status::OK);
+	}
+
+	void OnWriteDone(bool ok) override
+	{
+		const grpc_stream_Frame *next = nullptr;
+		bool finishNow = false;
+
+		{
+			std::lock_guard<std::mutex> grd(m_writeMtx);
+			m_writeQueue.pop_front();
+
+			if (!ok)
+			{
+				m_writeQueue.clear();
+				m_closing = true;
+			}
+
+			if (!m_writeQueue.empty())
+				next = &m_writeQueue.front();
+			else
+				m_writeInFlight = false;
+
+			finishNow = next == nullptr && m_closing && claimFinish();
+		}
+
+		// Neither under the lock, either can re-enter this reactor (Finish can delete it through OnDone)
+		if (next != nullptr)
+			StartWrite(next);
+		else if (finishNow)
+			Finish(grpc::Status::OK);
+	}
+
+	void OnDone() override
+	{
+		GrpcPlugin::instance().detachStream(this);
+		delete this;
+	}
+
+private:
+	// Called with m_writeMtx held, true for the one caller that should call Finish
+	bool claimFinish()
+	{
+		if (m_finished)
+			return false;
+
+		m_finished = true;
+		return true;
+	}
+
+	grpc_js_api_Request m_request;
+
+	std::mutex m_writeMtx;
+	std::deque<grpc_stream_Frame> m_writeQueue;
+	bool m_writeInFlight = false;
+	bool m_closing = false;
+	bool m_finished = false;
+};
+
+class grpc_plugin_objImpl final : public grpc_plugin_obj::CallbackService
+{
+	grpc::ServerUnaryReactor *com_grpc_js_api(grpc::CallbackServerContext *context, const grpc_js_api_Request *request, grpc_js_api_Reply *response) override
+	{
+		auto reactor = context->DefaultReactor();
+
+		// Finished from the js handler thread once the result is known
+		PluginJsHandler::instance().pushApiRequest(*request, [reactor, response, browserId = request->browserid()](const int funcId, const std::string &jsonReturn) {
+			response->set_funcid(funcId);
+			response->set_browserid(browserId);
+			response->set_jsonstr(jsonReturn);
+			reactor->Finish(grpc::Status::OK);
+		});
+
+		return reactor;
+	}
+
+	grpc::ServerUnaryReactor *com_grpc_js_cancel(grpc::CallbackServerContext *context, const grpc_js_api_Cancel *request, grpc_empty_Reply *response) override
+	{
+		PluginJsHandler::instance().cancelRequests(request->browserid(), request->navigation(), request->closed());
+
+		auto reactor = context->DefaultReactor();
+		reactor->Finish(grpc::Status::OK);
+		return reactor;
+	}
+
+	grpc::ServerUnaryReactor *com_grpc_ready(grpc::CallbackServerContext *context, const grpc_ready_Request *request, grpc_empty_Reply *response) override
+	{
+		GrpcPlugin::instance().setProxyReady(request->pid());
+
+		auto reactor = context->DefaultReactor();
+		reactor->Finish(grpc::Status::OK);
+		return reactor;
+	}
+
+	grpc::ServerBidiReactor<grpc_js_api_Request, grpc_stream_Frame> *com_grpc_js_stream(grpc::CallbackServerContext *context) override { return new grpc_plugin_objStream(); }
 };
 
 /***
@@ -25,50 +182,63 @@ class grpc_plugin_objImpl final : public grpc_plugin_obj::Service
 
 grpc_plugin_objClient::grpc_plugin_objClient(std::shared_ptr<grpc::Channel> channel) : stub_(grpc_proxy_obj::NewStub(channel))
 {
-	m_connected = channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(3));
+	// Doesn't wait, the channel connects in the background and the proxy announces itself with com_grpc_ready
 }
 
-bool grpc_plugin_objClient::send_executeCallback(const int functionId, const std::string &jsonStr)
+bool grpc_plugin_objClient::send_frame(const grpc_stream_Frame &frame)
 {
-	grpc_js_api_ExecuteCallback request;
-	request.set_funcid(functionId);
-	request.set_jsonstr(jsonStr.c_str());
-
-	grpc_js_api_Reply reply;
-	grpc::ClientContext context;
-	grpc::Status status = stub_->com_grpc_js_executeCallback(&context, request, &reply);
-
-	if (!status.ok())
-		return m_connected = false;
+	// Prefer the proxy's stream, unary calls are only used while it isn't attached
+	if (!GrpcPlugin::instance().writeFrame(frame))
+		return false;
 
+	m_connected = true;
 	return true;
 }
 
 bool grpc_plugin_objClient::send_executeJavascript(const std::string& codeStr)
 {
-	grpc_run_javascriptOnBrowser request;
-	request.set_str(codeStr.c_str());
+	grpc_stream_Frame frame;
+	frame.mutable_javascript()->set_str(codeStr);
+
+	if (send_frame(frame))
+		return true;
+
+	const grpc_run_javascriptOnBrowser &request = frame.javascript();
 
 	grpc_empty_Reply reply;
 	grpc::ClientContext context;
+	context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(3));
 	grpc::Status status = stub_->com_grpc_run_javascriptOnBrowser(&context, request, &reply);
 
 	if (!status.ok())
-		return m_connected = false;
+	{
+		m_connected = false;
+		return GrpcPlugin::instance().holdFrame(frame);
+	}
 
 	return true;
 }
 
 bool grpc_plugin_objClient::send_windowToggleVisibility()
 {
-	grpc_window_toggleVisibility request;
+	grpc_stream_Frame frame;
+	frame.mutable_togglevisibility();
+
+	if (send_frame(frame))
+		return true;
+
+	const grpc_window_toggleVisibility &request = frame.togglevisibility();
 
 	grpc_empty_Reply reply;
 	grpc::ClientContext context;
+	context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(3));
 	grpc::Status status = stub_->com_grpc_window_toggleVisibility(&context, request, &reply);
 
 	if (!status.ok())
-		return m_connected = false;
+	{
+		m_connected = false;
+		return GrpcPlugin::instance().holdFrame(frame);
+	}
 
 	return true;
 }
@@ -80,39 +250,221 @@ GrpcPlugin::GrpcPlugin() {}
 
 GrpcPlugin::~GrpcPlugin() {}
 
-bool GrpcPlugin::startServer(int32_t listenPort)
+bool GrpcPlugin::startServer(const std::string &listenAddress)
 {
 	// Don't repeat
-	if (m_listenPort != 0)
+	if (!m_listenAddress.empty())
 		return false;
 
-	m_listenPort = listenPort;
+	m_listenAddress = listenAddress;
+
+	// Left over from a crash, binding would fail otherwise
+	GrpcTransport::removeUnixSocket(m_listenAddress);
 
 	grpc::EnableDefaultHealthCheckService(true);
 	grpc::reflection::InitProtoReflectionServerBuilderPlugin();
 
 	m_builder = std::make_unique<grpc::ServerBuilder>();
-	m_builder->AddListeningPort(std::string("localhost:") + std::to_string(m_listenPort), grpc::InsecureServerCredentials());
+	m_builder->AddListeningPort(m_listenAddress, grpc::InsecureServerCredentials());
 
 	m_serverObj = std::make_unique<grpc_plugin_objImpl>();
+	m_serverObj->SetMessageAllocatorFor_com_grpc_js_api(&m_apiAllocator);
 	m_builder->RegisterService(m_serverObj.get());
 
 	m_server = m_builder->BuildAndStart();
 
+	// Optional, results are sent inline without it
+	if (m_server != nullptr && !m_payloadRing.create(GetCurrentProcessId()))
+		blog(LOG_WARNING, "GrpcPlugin: failed to create the shared payload ring, GetLastError = %d", GetLastError());
+
+	// Allow a retry on another transport
+	if (m_server == nullptr)
+		m_listenAddress.clear();
+
 	return m_server != nullptr;
 }
 
-bool GrpcPlugin::connectToClient(int32_t portNumber)
+bool GrpcPlugin::connectToClient(const std::string &address)
 {
-	m_clientObj = std::make_unique<grpc_plugin_objClient>(grpc::CreateChannel("localhost:" + std::to_string(portNumber), grpc::InsecureChannelCredentials()));
+	m_clientObj = std::make_unique<grpc_plugin_objClient>(GrpcReconnect::createChannel(address));
 	return m_clientObj != nullptr;
 }
 
+void GrpcPlugin::attachStream(grpc_plugin_objStream *stream)
+{
+	{
+		std::lock_guard<std::mutex> grd(m_streamMtx);
+		m_stream = stream;
+
+		// Whatever was held while the proxy was away goes out before anything new
+		for (auto &itr : m_heldFrames)
+			m_stream->queueFrame(itr);
+
+		m_heldFrames.clear();
+	}
+
+	ObsEventChannel::instance().onStreamAttached();
+}
+
+void GrpcPlugin::detachStream(grpc_plugin_objStream *stream)
+{
+	std::lock_guard<std::mutex> grd(m_streamMtx);
+
+	if (m_stream == stream)
+		m_stream = nullptr;
+}
+
+bool GrpcPlugin::writeFrame(const grpc_stream_Frame &frame)
+{
+	std::lock_guard<std::mutex> grd(m_streamMtx);
+
+	if (m_stream == nullptr)
+		return false;
+
+	return m_stream->queueFrame(frame);
+}
+
+bool GrpcPlugin::holdFrame(const grpc_stream_Frame &frame, const bool overBudget)
+{
+	std::lock_guard<std::mutex> grd(m_streamMtx);
+
+	// Attached in the meantime
+	if (m_stream != nullptr)
+		return m_stream->queueFrame(frame);
+
+	if (m_heldFrames.size() >= GrpcReconnect::kMaxPending && !overBudget)
+		return false;
+
+	m_heldFrames.push_back(frame);
+	return true;
+}
+
+bool GrpcPlugin::writeOrHoldFrame(const grpc_stream_Frame &frame, const bool overBudget)
+{
+	// The proxy reopens its stream after a stall, the frame waits for it
+	return writeFrame(frame) || holdFrame(frame, overBudget);
+}
+
+bool GrpcPlugin::writeReply(const int funcId, const int browserId, const std::string &jsonReturn)
+{
+	if (jsonReturn.size() >= PayloadChunks::kThreshold && writeChunkedReply(funcId, browserId, jsonReturn))
+		return true;
+
+	grpc_stream_Frame frame;
+	grpc_js_api_Reply &reply = *frame.mutable_reply();
+	reply.set_funcid(funcId);
+	reply.set_browserid(browserId);
+
+	uint64_t offset = 0;
+
+	// Replies come from every lane worker, the ring takes one writer and its handles have to reach the proxy in ring order
+	//	(reading a record releases everything before it)
+	std::unique_lock<std::mutex> ringLock(m_payloadRingMtx, std::defer_lock);
+
+	if (jsonReturn.size() >= SharedPayloadRing::kThreshold)
+		ringLock.lock();
+
+	if (ringLock.owns_lock() && m_payloadRing.write(jsonReturn, offset))
+	{
+		reply.set_shmoffset(offset);
+		reply.set_shmlength(jsonReturn.size());
+	}
+	else
+	{
+		reply.set_jsonstr(jsonReturn);
+	}
+
+	return writeOrHoldFrame(frame);
+}
+
+bool GrpcPlugin::writeEvents(const int funcId, const int browserId, const std::string &jsonEvents)
+{
+	grpc_stream_Frame frame;
+	grpc_js_api_Events &events = *frame.mutable_events();
+	events.set_funcid(funcId);
+	events.set_browserid(browserId);
+	events.set_jsonstr(jsonEvents);
+	return writeFrame(frame);
+}
+
+bool GrpcPlugin::writeChunkedReply(const int funcId, const int browserId, const std::string &jsonReturn)
+{
+	const size_t chunkCount = (jsonReturn.size() + PayloadChunks::kChunkSize - 1) / PayloadChunks::kChunkSize;
+
+	// Each chunk goes out as soon as it's compressed, the proxy is already forwarding the first while the rest are prepared
+	for (size_t i = 0; i < chunkCount; ++i)
+	{
+		const size_t offset = i * PayloadChunks::kChunkSize;
+		const size_t length = std::min(PayloadChunks::kChunkSize, jsonReturn.size() - offset);
+
+		grpc_stream_Frame frame;
+		grpc_js_api_Chunk &chunk = *frame.mutable_chunk();
+		chunk.set_funcid(funcId);
+		chunk.set_browserid(browserId);
+		chunk.set_seq(uint32_t(i));
+		chunk.set_last(i + 1 == chunkCount);
+		chunk.set_rawlength(uint32_t(length));
+
+		bool sent = PayloadChunks::compress(jsonReturn.data() + offset, length, *chunk.mutable_data()) && writeOrHoldFrame(frame);
+
+		// Nothing sent yet, the caller can still send it whole
+		if (!sent && i == 0)
+			return false;
+
+		if (!sent)
+		{
+			blog(LOG_ERROR, "GrpcPlugin: chunk %d of reply %d could not be sent", int(i), funcId);
+
+			// The renderer is holding the first part, end the reply so the page gets its error now and not at its timeout (or never)
+			grpc_stream_Frame lostFrame;
+			grpc_js_api_Chunk &lost = *lostFrame.mutable_chunk();
+			lost.set_funcid(funcId);
+			lost.set_browserid(browserId);
+			lost.set_seq(uint32_t(i));
+			lost.set_last(true);
+			lost.set_lost(true);
+			writeOrHoldFrame(lostFrame, true);
+			return true;
+		}
+	}
+
+	return true;
+}
+
+void GrpcPlugin::setProxyReady(const uint32_t pid)
+{
+	blog(LOG_INFO, "GrpcPlugin: proxy %d is ready", pid);
+
+	{
+		std::lock_guard<std::mutex> grd(m_readyMtx);
+		m_proxyReady = true;
+	}
+
+	m_readyCv.notify_all();
+}
+
+bool GrpcPlugin::waitForProxyReady(const std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock(m_readyMtx);
+	m_readyCv.wait_for(lock, timeout, [this]() { return m_proxyReady || m_stopping; });
+
+	// Nothing to report if we're shutting down anyway
+	return m_proxyReady || m_stopping;
+}
+
 void GrpcPlugin::stop()
 {
+	{
+		std::lock_guard<std::mutex> grd(m_readyMtx);
+		m_stopping = true;
+	}
+
+	m_readyCv.notify_all();
+
 	if (m_server != nullptr)
 	{
-		m_server->Shutdown();
+		// The js stream is held open by the proxy, don't wait on it forever
+		m_server->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(1));
 		m_server->Wait();
 		m_server.reset();
 	}
@@ -120,4 +472,7 @@ void GrpcPlugin::stop()
 	m_clientObj = nullptr;
 	m_serverObj = nullptr;
 	m_builder = nullptr;
+
+	GrpcTransport::removeUnixSocket(m_listenAddress);
+	m_payloadRing.close();
 }
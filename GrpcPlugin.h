@@ -1,8 +1,16 @@
 #pragma once
 
 #include "sl_browser_api.grpc.pb.h"
+#include "GrpcArena.h"
+#include "GrpcReconnect.h"
+#include "GrpcTransport.h"
+#include "PayloadChunks.h"
+#include "SharedPayloadRing.h"
 
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <mutex>
 
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
 #include <grpcpp/grpcpp.h>
@@ -13,15 +21,18 @@ class grpc_plugin_objClient
 public:
 	grpc_plugin_objClient(std::shared_ptr<grpc::Channel> channel);
 
-	bool send_executeCallback(const int functionId, const std::string &jsonStr);
 	bool send_executeJavascript(const std::string &codeStr);
 	bool send_windowToggleVisibility();
 
 private:
+	bool send_frame(const grpc_stream_Frame &frame);
+
 	std::atomic<bool> m_connected{false};
 	std::unique_ptr<grpc_proxy_obj::Stub> stub_;
 };
 
+class grpc_plugin_objStream;
+
 class GrpcPlugin
 {
 public:
@@ -31,22 +42,60 @@ public:
 		return a;
 	}
 
-	bool connectToClient(int32_t port);
-	bool startServer(int32_t port);
+	// Addresses come from GrpcTransport, either unix: or localhost:<port>
+	bool connectToClient(const std::string &address);
+	bool startServer(const std::string &address);
 
 	void stop();
 
+	// Handshake, the proxy calls com_grpc_ready once it's listening
+	void setProxyReady(const uint32_t pid);
+	// False only if the proxy didn't show up in time
+	bool waitForProxyReady(const std::chrono::milliseconds timeout);
+
+	// The proxy's js stream, frames written here are multiplexed back to the browser
+	void attachStream(grpc_plugin_objStream *stream);
+	void detachStream(grpc_plugin_objStream *stream);
+	bool writeFrame(const grpc_stream_Frame &frame);
+
+	// Kept while the proxy is reconnecting and sent first on its next stream, false if too much is waiting
+	//	'overBudget' holds it regardless, for the small frames that end a reply the renderer has already started on
+	bool holdFrame(const grpc_stream_Frame &frame, const bool overBudget = false);
+
+	// Any lane worker, the shared ring is serialized inside
+	//	Inline, through the shared ring or as compressed chunks depending on size
+	bool writeReply(const int funcId, const int browserId, const std::string &jsonReturn);
+
+	// Any thread. Not held while the proxy is reconnecting, they'd crowd out replies. False then, the channel owes the page an overflow notice
+	bool writeEvents(const int funcId, const int browserId, const std::string &jsonEvents);
+
 	auto getClient() const { return m_clientObj.get(); }
 
 private:
 	GrpcPlugin();
 	~GrpcPlugin();
 
-	int32_t m_listenPort{0};
+	bool writeChunkedReply(const int funcId, const int browserId, const std::string &jsonReturn);
+	bool writeOrHoldFrame(const grpc_stream_Frame &frame, const bool overBudget = false);
+
+	std::string m_listenAddress;
 
 	std::wstring m_modulePath;
 	std::unique_ptr<grpc::Server> m_server;
 	std::unique_ptr<grpc::ServerBuilder> m_builder;
-	std::unique_ptr<grpc_plugin_obj::Service> m_serverObj;
+	std::unique_ptr<grpc_plugin_obj::CallbackService> m_serverObj;
+	GrpcArenaAllocator<grpc_js_api_Request, grpc_js_api_Reply> m_apiAllocator;
 	std::unique_ptr<grpc_plugin_objClient> m_clientObj;
+
+	std::mutex m_streamMtx;
+	grpc_plugin_objStream *m_stream = nullptr;
+	std::deque<grpc_stream_Frame> m_heldFrames;
+
+	std::mutex m_payloadRingMtx;
+	SharedPayloadRing m_payloadRing;
+
+	std::mutex m_readyMtx;
+	std::condition_variable m_readyCv;
+	bool m_proxyReady = false;
+	bool m_stopping = false;
 };
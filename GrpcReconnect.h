@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include <grpcpp/grpcpp.h>
+
+/***
+* Reconnecting the plugin <-> proxy channel
+*	A stall on the other side (obs busy loading a scene collection, a debugger) drops the link for a moment, that isn't a reason to kill the browser
+*	Channels redial on their own with the backoff below, calls made while the link is down wait in a bounded queue and are replayed in order
+*/
+
+namespace GrpcReconnect
+{
+	// Past this the caller is told the call failed instead of it being held
+	static constexpr size_t kMaxPending = 256;
+
+	static constexpr int kInitialBackoffMs = 100;
+	static constexpr int kMaxBackoffMs = 5000;
+
+	static grpc::ChannelArguments channelArguments()
+	{
+		grpc::ChannelArguments args;
+		args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, kInitialBackoffMs);
+		args.SetInt(GRPC_ARG_MIN_RECONNECT_BACKOFF_MS, kInitialBackoffMs);
+		args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, kMaxBackoffMs);
+		return args;
+	}
+
+	static std::shared_ptr<grpc::Channel> createChannel(const std::string &address)
+	{
+		return grpc::CreateCustomChannel(address, grpc::InsecureChannelCredentials(), channelArguments());
+	}
+
+	// Doubling delay between attempts that got through to the channel but not the rpc
+	class Backoff
+	{
+	public:
+		std::chrono::milliseconds next()
+		{
+			const int delayMs = m_delayMs;
+			m_delayMs = std::min(m_delayMs * 2, kMaxBackoffMs);
+			return std::chrono::milliseconds(delayMs);
+		}
+
+		void reset() { m_delayMs = kInitialBackoffMs; }
+
+	private:
+		int m_delayMs = kInitialBackoffMs;
+	};
+}
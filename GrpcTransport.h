@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "Utf8Path.h"
+
+/***
+* Addresses for the plugin <-> proxy channel
+*	Unix domain sockets are preferred, loopback tcp is the fallback if they can't be bound
+*	gRPC has no named pipe transport, AF_UNIX is used on Windows as well (Windows 10 1803+)
+*/
+
+namespace GrpcTransport
+{
+	static const char *kUnixPrefix = "unix:";
+	static const char *kUnixLaunchArg = "unix";
+
+	static std::string tcpAddress(const int32_t port)
+	{
+		return "localhost:" + std::to_string(port);
+	}
+
+	// Both processes derive the same path from the plugin's pid, so only 'unix' has to go through argv
+	static std::string unixAddress(const uint32_t ownerPid, const std::string &role)
+	{
+		std::error_code ec;
+		std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+
+		if (ec)
+			return "";
+
+		std::filesystem::path socketPath = dir / ("sl-browser-" + std::to_string(ownerPid) + "-" + role + ".sock");
+		return kUnixPrefix + Utf8Path::toString(socketPath.u8string());
+	}
+
+	static bool isUnixAddress(const std::string &address)
+	{
+		return address.rfind(kUnixPrefix, 0) == 0;
+	}
+
+	// Launch arguments are either 'unix' or a port number
+	static std::string fromLaunchArg(const std::string &arg, const uint32_t ownerPid, const std::string &role)
+	{
+		if (arg == kUnixLaunchArg)
+			return unixAddress(ownerPid, role);
+
+		return tcpAddress(std::atoi(arg.c_str()));
+	}
+
+	static void removeUnixSocket(const std::string &address)
+	{
+		if (!isUnixAddress(address))
+			return;
+
+		std::error_code ec;
+		std::filesystem::remove(Utf8Path::toPath(address.substr(strlen(kUnixPrefix))), ec);
+	}
+}
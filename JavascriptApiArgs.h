@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include "JsArgs.h"
+
+class CefListValue;
+
+/***
+* Typed arguments for plugin functions, one protobuf message per function generated from sl_browser_api.idl
+*	Sent as grpc_js_api_Request.args instead of the json 'params' string
+*/
+
+namespace JavascriptApiArgs
+{
+	// Proxy, false if the function isn't a plugin function
+	bool encode(const int apiId, CefListValue *list, std::string &out_args);
+
+	// Plugin, param2 onward in order, what the typed handlers bind by position
+	bool decode(const int apiId, const std::string &args, JsArgs &out_args);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "JsonDocument.h"
+
+/***
+* A call's arguments, param2 onward, what the typed handlers bind by position
+*	Filled straight from the typed grpc message, or from the parsed json array on the params and batch paths
+*	Strings are moved in here and moved on into the handler, there's no tree of values in between
+*	An object or array is kept as its json text, a json string parameter takes it as is (batch calls pass settings as objects)
+*/
+
+class JsArgs
+{
+public:
+	// Most parameters any function in sl_browser_api.idl has, generate_js_api.py checks it
+	static constexpr size_t kMaxArgs = 8;
+
+	struct Arg
+	{
+		enum Type : uint8_t
+		{
+			MISSING,
+			NUL,
+			NUMBER,
+			BOOL,
+			STRING,
+			JSON
+		};
+
+		// Left out reads the same as null
+		bool is_null() const { return type == MISSING || type == NUL; }
+
+		Type type = MISSING;
+		bool flag = false;
+		double number = 0;
+		// STRING the value, JSON the object or array's source
+		std::string text;
+	};
+
+	size_t size() const { return m_size; }
+
+	// Past the end is MISSING, a trailing argument left out binds to its default
+	Arg &operator[](const size_t index) { return index < m_size ? m_args[index] : m_missing; }
+	const Arg &operator[](const size_t index) const { return index < m_size ? m_args[index] : m_missing; }
+
+	void addString(std::string value)
+	{
+		if (Arg *arg = next(Arg::STRING))
+			arg->text = std::move(value);
+	}
+
+	void addNumber(const double value)
+	{
+		if (Arg *arg = next(Arg::NUMBER))
+			arg->number = value;
+	}
+
+	void addBool(const bool value)
+	{
+		if (Arg *arg = next(Arg::BOOL))
+			arg->flag = value;
+	}
+
+	void add(const JsonNode &value)
+	{
+		switch (value.type())
+		{
+		case JsonNode::NUMBER: addNumber(value.number_value()); break;
+		case JsonNode::BOOL: addBool(value.bool_value()); break;
+		case JsonNode::STRING: addString(std::string(value.string_value())); break;
+		case JsonNode::ARRAY:
+		case JsonNode::OBJECT:
+		{
+			if (Arg *arg = next(Arg::JSON))
+				arg->text = value.raw();
+
+			break;
+		}
+		default: next(Arg::NUL); break;
+		}
+	}
+
+private:
+	// Anything past kMaxArgs isn't a parameter of any function, dropped
+	Arg *next(const Arg::Type type)
+	{
+		if (m_size == kMaxArgs)
+			return nullptr;
+
+		Arg &arg = m_args[m_size++];
+		arg.type = type;
+		return &arg;
+	}
+
+	std::array<Arg, kMaxArgs> m_args;
+	size_t m_size = 0;
+	Arg m_missing;
+};
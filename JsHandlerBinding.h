@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "JsArgs.h"
+#include "JsTask.h"
+#include "JsonWriter.h"
+
+/***
+* Typed Javascript API handlers
+*	A handler declares its C++ signature, e.g. JS_SET_SCENEITEM_POS(std::string scene_name, std::string source_name, float x, float y)
+*	Its arguments are bound by position from the call's JsArgs (param2 onward), no string keyed lookups, no params object and no json tree
+*	A missing trailing argument is its type's default like the typed grpc path sends, a present one of the wrong type fails the call
+*/
+
+namespace JsHandlerBinding
+{
+	template<typename T> struct Arg;
+
+	template<> struct Arg<std::string>
+	{
+		// An object or array is its json text, what a settings_jsonStr style parameter wants either way
+		static bool convert(JsArgs::Arg &value, std::string &out_value)
+		{
+			if (value.type == JsArgs::Arg::STRING || value.type == JsArgs::Arg::JSON)
+				out_value = std::move(value.text);
+
+			return value.is_null() || value.type == JsArgs::Arg::STRING || value.type == JsArgs::Arg::JSON;
+		}
+	};
+
+	template<> struct Arg<bool>
+	{
+		static bool convert(JsArgs::Arg &value, bool &out_value)
+		{
+			out_value = value.type == JsArgs::Arg::BOOL && value.flag;
+			return value.is_null() || value.type == JsArgs::Arg::BOOL;
+		}
+	};
+
+	template<> struct Arg<int>
+	{
+		static bool convert(JsArgs::Arg &value, int &out_value)
+		{
+			out_value = value.type == JsArgs::Arg::NUMBER ? int(value.number) : 0;
+			return value.is_null() || value.type == JsArgs::Arg::NUMBER;
+		}
+	};
+
+	template<> struct Arg<float>
+	{
+		static bool convert(JsArgs::Arg &value, float &out_value)
+		{
+			out_value = value.type == JsArgs::Arg::NUMBER ? float(value.number) : 0;
+			return value.is_null() || value.type == JsArgs::Arg::NUMBER;
+		}
+	};
+
+	template<> struct Arg<double>
+	{
+		static bool convert(JsArgs::Arg &value, double &out_value)
+		{
+			out_value = value.type == JsArgs::Arg::NUMBER ? value.number : 0;
+			return value.is_null() || value.type == JsArgs::Arg::NUMBER;
+		}
+	};
+
+	template<typename Tuple, size_t... Index> bool bind(JsArgs &args, Tuple &out_values, std::index_sequence<Index...>)
+	{
+		return (Arg<std::tuple_element_t<Index, Tuple>>::convert(args[Index], std::get<Index>(out_values)) && ...);
+	}
+
+	// One dispatch table entry, a coroutine handler comes back as a task that hasn't started, anything else has filled 'out_jsonReturn'
+	template<typename Owner> using Invoker = JsTask (*)(Owner &owner, JsArgs &args, std::string &out_jsonReturn);
+
+	template<auto Handler> struct Bound;
+
+	template<typename Owner, typename Result, typename... Args, Result (Owner::*Handler)(Args...)> struct Bound<Handler>
+	{
+		static JsTask invoke(Owner &owner, JsArgs &args, std::string &out_jsonReturn)
+		{
+			std::tuple<std::decay_t<Args>...> values;
+
+			if (!bind(args, values, std::index_sequence_for<Args...>{}))
+			{
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+				return JsTask();
+			}
+
+			auto call = [&owner](auto &&...values) { return (owner.*Handler)(std::move(values)...); };
+
+			if constexpr (std::is_same_v<Result, JsTask>)
+			{
+				return std::apply(call, std::move(values));
+			}
+			else
+			{
+				static_assert(std::is_same_v<Result, std::string>, "typed handlers return a JsTask or the json result");
+				out_jsonReturn = std::apply(call, std::move(values));
+				return JsTask();
+			}
+		}
+	};
+}
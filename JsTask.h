@@ -0,0 +1,156 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <QMetaObject>
+#include <QObject>
+#include <QThread>
+
+#include "JsonWriter.h"
+
+/***
+* Coroutine Javascript API handlers
+*	A handler that needs the Qt main thread awaits the hop instead of blocking its lane worker on it, the worker moves on to the next call meanwhile
+*	The handler comes back to the lane it started on once the Qt side ran, so the reply is never written from the ui thread
+*/
+
+class JsTask
+{
+public:
+	// Hands a suspended handler back to whatever runs it next (a lane worker)
+	using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+	struct promise_type
+	{
+		std::function<void(const std::string &)> onDone;
+
+		// See setStaleCheck
+		std::function<bool()> isStale;
+		std::string staleReturn;
+		bool stale = false;
+
+		JsTask get_return_object() { return JsTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+		// Nothing runs until start(), the completion has to be in place first
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+		// The frame frees itself once the handler returns
+		std::suspend_never final_suspend() noexcept { return {}; }
+
+		void return_value(const std::string &jsonReturn) { onDone(stale ? staleReturn : jsonReturn); }
+
+		// Qt thread, right before a hop's work
+		bool skipHop()
+		{
+			stale = stale || (isStale && isStale());
+			return stale;
+		}
+
+		void unhandled_exception() { onDone(JsonWriter::object(JsonKeys::kError, "Internal error")); }
+	};
+
+	// Resumes on the Qt thread that owns 'target', runs 'func' there, then hands the handler to 'resumer'
+	struct QtHop
+	{
+		QObject *target;
+		std::function<void()> func;
+		Resumer resumer;
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(std::coroutine_handle<promise_type> handle)
+		{
+			// Already there (a batch), runs inline and the handler carries on without suspending
+			if (target != nullptr && QThread::currentThread() == target->thread())
+			{
+				if (!handle.promise().skipHop())
+					func();
+
+				return false;
+			}
+
+			// Queued posts run in order, calls from the same lane still reach Qt in the order they arrived
+			const bool posted = QMetaObject::invokeMethod(
+				target,
+				[func = std::move(func), resumer = resumer, handle]() {
+					if (!handle.promise().skipHop())
+						func();
+
+					resumer(handle);
+				},
+				Qt::QueuedConnection);
+
+			if (!posted)
+				resumer(handle);
+
+			return true;
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	// Moves the handler onto another runner, e.g. the io lane for blocking file work
+	struct Hop
+	{
+		Resumer resumer;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { resumer(handle); }
+		void await_resume() const noexcept {}
+	};
+
+	JsTask() = default;
+
+	JsTask(JsTask &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+	JsTask &operator=(JsTask &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+
+		return *this;
+	}
+
+	JsTask(const JsTask &) = delete;
+	JsTask &operator=(const JsTask &) = delete;
+
+	~JsTask() { reset(); }
+
+	bool valid() const { return m_handle != nullptr; }
+
+	// Checked on the Qt thread right before each hop's work, once it says the call went stale the work is dropped and the result is 'staleReturn'
+	//	For calls that can be superseded while they wait in the Qt event queue
+	void setStaleCheck(std::function<bool()> isStale, std::string staleReturn)
+	{
+		m_handle.promise().isStale = std::move(isStale);
+		m_handle.promise().staleReturn = std::move(staleReturn);
+	}
+
+	// Runs up to the first hop on the calling thread, 'onDone' gets the result on whichever thread the handler finishes on
+	void start(std::function<void(const std::string &)> onDone)
+	{
+		auto handle = std::exchange(m_handle, nullptr);
+		handle.promise().onDone = std::move(onDone);
+		handle.resume();
+	}
+
+private:
+	explicit JsTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+	// Only a task that never started still owns its frame
+	void reset()
+	{
+		if (m_handle)
+			m_handle.destroy();
+
+		m_handle = nullptr;
+	}
+
+	std::coroutine_handle<promise_type> m_handle;
+};
@@ -0,0 +1,670 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SL_JSON_SSE2 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#include <json11/json11.hpp>
+
+#include "JsonKey.h"
+
+/***
+* Read only json for hot paths, parsed into one monotonic arena instead of a shared_ptr per node and a std::map per object
+*	Strings and keys without escapes are views into the input, the input has to outlive the document
+*	Every value keeps the span of input it came from, writing it back out is a copy of that span instead of a dump()
+*	Keys are hashed as they're parsed, a lookup with a JsonKey constant compares hashes before any bytes
+*	The accessors follow json11's names so call sites read the same, toJson() is there for code that still takes a json11::Json
+*/
+
+class JsonDocument;
+
+class JsonNode
+{
+public:
+	enum Type : uint8_t
+	{
+		NUL,
+		NUMBER,
+		BOOL,
+		STRING,
+		ARRAY,
+		OBJECT
+	};
+
+	struct Member;
+
+	Type type() const { return m_type; }
+	bool is_null() const { return m_type == NUL; }
+	bool is_number() const { return m_type == NUMBER; }
+	bool is_bool() const { return m_type == BOOL; }
+	bool is_string() const { return m_type == STRING; }
+	bool is_array() const { return m_type == ARRAY; }
+	bool is_object() const { return m_type == OBJECT; }
+
+	double number_value() const { return m_type == NUMBER ? m_number : 0; }
+	int int_value() const { return m_type == NUMBER ? int(m_number) : 0; }
+	bool bool_value() const { return m_type == BOOL && m_bool; }
+	std::string_view string_value() const { return m_type == STRING ? std::string_view(m_string, m_size) : std::string_view(); }
+
+	// Items of an array or members of an object
+	size_t size() const { return m_type == ARRAY || m_type == OBJECT ? m_size : 0; }
+	const JsonNode *begin() const { return m_type == ARRAY ? m_items : nullptr; }
+	const JsonNode *end() const { return m_type == ARRAY ? m_items + m_size : nullptr; }
+	const Member *members() const { return m_type == OBJECT ? m_members : nullptr; }
+
+	// Out of range or missing is null, like json11
+	inline const JsonNode &operator[](const size_t index) const;
+	inline const JsonNode &operator[](const std::string_view key) const;
+	inline const JsonNode &operator[](const JsonKey &key) const;
+
+	// Exactly the input this value was parsed from
+	std::string_view raw() const { return std::string_view(m_raw, m_rawSize); }
+
+	inline json11::Json toJson() const;
+
+private:
+	friend class JsonDocument;
+
+	Type m_type = NUL;
+	bool m_bool = false;
+	size_t m_size = 0;
+
+	union
+	{
+		double m_number = 0;
+		const char *m_string;
+		const JsonNode *m_items;
+		const Member *m_members;
+	};
+
+	const char *m_raw = "null";
+	size_t m_rawSize = 4;
+};
+
+struct JsonNode::Member
+{
+	std::string_view key;
+	uint32_t keyHash = 0;
+	JsonNode value;
+};
+
+inline const JsonNode &JsonNode::operator[](const size_t index) const
+{
+	static const JsonNode null;
+	return m_type == ARRAY && index < m_size ? m_items[index] : null;
+}
+
+inline const JsonNode &JsonNode::operator[](const std::string_view key) const
+{
+	return (*this)[JsonKey(key)];
+}
+
+inline const JsonNode &JsonNode::operator[](const JsonKey &key) const
+{
+	static const JsonNode null;
+
+	// Objects coming from the page are a handful of keys, a scan beats a table
+	if (m_type == OBJECT)
+	{
+		for (size_t i = 0; i < m_size; ++i)
+		{
+			if (m_members[i].keyHash == key.hash() && m_members[i].key == key.name())
+				return m_members[i].value;
+		}
+	}
+
+	return null;
+}
+
+inline json11::Json JsonNode::toJson() const
+{
+	switch (m_type)
+	{
+	case NUMBER: return m_number;
+	case BOOL: return m_bool;
+	case STRING: return std::string(m_string, m_size);
+	case ARRAY:
+	{
+		json11::Json::array items;
+		items.reserve(m_size);
+
+		for (size_t i = 0; i < m_size; ++i)
+			items.push_back(m_items[i].toJson());
+
+		return items;
+	}
+	case OBJECT:
+	{
+		json11::Json::object members;
+
+		for (size_t i = 0; i < m_size; ++i)
+			members.emplace(std::string(m_members[i].key), m_members[i].value.toJson());
+
+		return members;
+	}
+	default: return nullptr;
+	}
+}
+
+class JsonDocument
+{
+public:
+	JsonDocument() = default;
+	JsonDocument(const JsonDocument &) = delete;
+	JsonDocument &operator=(const JsonDocument &) = delete;
+
+	// Replaces whatever was parsed before, the arena's first block is kept so a reused document stops allocating
+	bool parse(const std::string_view text, std::string &out_err)
+	{
+		reset();
+
+		m_pos = text.data();
+		m_end = text.data() + text.size();
+		m_err.clear();
+
+		skipWhitespace();
+
+		if (!parseValue(m_root, 0))
+		{
+			out_err = m_err;
+			m_root = JsonNode();
+			return false;
+		}
+
+		skipWhitespace();
+
+		if (m_pos != m_end)
+		{
+			out_err = "unexpected trailing " + describe();
+			m_root = JsonNode();
+			return false;
+		}
+
+		out_err.clear();
+		return true;
+	}
+
+	const JsonNode &root() const { return m_root; }
+
+private:
+	// Same as json11, deeper than this is someone trying to blow the stack
+	static constexpr int kMaxDepth = 200;
+	static constexpr size_t kBlockSize = 16 * 1024;
+
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		size_t size = 0;
+	};
+
+	void reset()
+	{
+		if (m_blocks.size() > 1)
+			m_blocks.resize(1);
+
+		m_used = 0;
+		m_root = JsonNode();
+		m_items.clear();
+		m_members.clear();
+	}
+
+	void *allocate(const size_t bytes, const size_t align)
+	{
+		if (!m_blocks.empty())
+		{
+			Block &block = m_blocks.back();
+			const size_t offset = (m_used + align - 1) & ~(align - 1);
+
+			if (offset + bytes <= block.size)
+			{
+				m_used = offset + bytes;
+				return block.data.get() + offset;
+			}
+		}
+
+		// Oversized requests get a block of their own
+		Block block;
+		block.size = bytes + align > kBlockSize ? bytes + align : kBlockSize;
+		block.data.reset(new char[block.size]);
+		m_blocks.push_back(std::move(block));
+
+		const uintptr_t base = reinterpret_cast<uintptr_t>(m_blocks.back().data.get());
+		const size_t offset = ((base + align - 1) & ~uintptr_t(align - 1)) - base;
+		m_used = offset + bytes;
+		return m_blocks.back().data.get() + offset;
+	}
+
+	template<typename T> const T *copyToArena(const T *first, const size_t count)
+	{
+		if (count == 0)
+			return nullptr;
+
+		T *out = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+		std::uninitialized_copy(first, first + count, out);
+		return out;
+	}
+
+	bool fail(const std::string &err)
+	{
+		m_err = err;
+		return false;
+	}
+
+	std::string describe() const { return m_pos < m_end ? "'" + std::string(1, *m_pos) + "'" : "end of input"; }
+
+	void skipWhitespace()
+	{
+		while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+			++m_pos;
+	}
+
+	bool consume(const std::string_view literal)
+	{
+		if (size_t(m_end - m_pos) < literal.size() || std::memcmp(m_pos, literal.data(), literal.size()) != 0)
+			return false;
+
+		m_pos += literal.size();
+		return true;
+	}
+
+	// First '"', '\\' or control character from 'p', where a plain string run ends
+	static const char *scanString(const char *p, const char *end)
+	{
+#ifdef SL_JSON_SSE2
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+
+		for (; end - p >= 16; p += 16)
+		{
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+
+			// Unsigned chunk < 0x20 is min(chunk, 0x1f) == chunk
+			const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1f)), chunk);
+			const __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), control);
+			const int mask = _mm_movemask_epi8(stop);
+
+			if (mask != 0)
+			{
+#ifdef _MSC_VER
+				unsigned long index;
+				_BitScanForward(&index, unsigned(mask));
+				return p + index;
+#else
+				return p + __builtin_ctz(unsigned(mask));
+#endif
+			}
+		}
+#endif
+
+		while (p < end && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20)
+			++p;
+
+		return p;
+	}
+
+	static void appendUtf8(std::string &out, const uint32_t codepoint)
+	{
+		if (codepoint < 0x80)
+		{
+			out += char(codepoint);
+		}
+		else if (codepoint < 0x800)
+		{
+			out += char(0xC0 | (codepoint >> 6));
+			out += char(0x80 | (codepoint & 0x3F));
+		}
+		else if (codepoint < 0x10000)
+		{
+			out += char(0xE0 | (codepoint >> 12));
+			out += char(0x80 | ((codepoint >> 6) & 0x3F));
+			out += char(0x80 | (codepoint & 0x3F));
+		}
+		else
+		{
+			out += char(0xF0 | (codepoint >> 18));
+			out += char(0x80 | ((codepoint >> 12) & 0x3F));
+			out += char(0x80 | ((codepoint >> 6) & 0x3F));
+			out += char(0x80 | (codepoint & 0x3F));
+		}
+	}
+
+	bool parseHex4(uint32_t &out_value)
+	{
+		if (m_end - m_pos < 4)
+			return fail("bad \\u escape");
+
+		out_value = 0;
+
+		for (int i = 0; i < 4; ++i, ++m_pos)
+		{
+			const char ch = *m_pos;
+			out_value <<= 4;
+
+			if (ch >= '0' && ch <= '9')
+				out_value |= ch - '0';
+			else if (ch >= 'a' && ch <= 'f')
+				out_value |= ch - 'a' + 10;
+			else if (ch >= 'A' && ch <= 'F')
+				out_value |= ch - 'A' + 10;
+			else
+				return fail("bad \\u escape");
+		}
+
+		return true;
+	}
+
+	// At the opening quote
+	bool parseString(std::string_view &out_value)
+	{
+		const char *start = ++m_pos;
+		m_pos = scanString(m_pos, m_end);
+
+		// The common case, nothing to unescape so the input is the value
+		if (m_pos < m_end && *m_pos == '"')
+		{
+			out_value = std::string_view(start, m_pos - start);
+			++m_pos;
+			return true;
+		}
+
+		std::string &decoded = m_scratch;
+		decoded.assign(start, m_pos - start);
+
+		while (m_pos < m_end)
+		{
+			const char ch = *m_pos;
+
+			if (ch == '"')
+			{
+				++m_pos;
+				char *copy = static_cast<char *>(allocate(decoded.size() + 1, 1));
+				std::memcpy(copy, decoded.data(), decoded.size());
+				out_value = std::string_view(copy, decoded.size());
+				return true;
+			}
+
+			if (static_cast<unsigned char>(ch) < 0x20)
+				return fail("unescaped control character in string");
+
+			if (ch != '\\')
+			{
+				const char *run = scanString(m_pos, m_end);
+				decoded.append(m_pos, run - m_pos);
+				m_pos = run;
+				continue;
+			}
+
+			if (++m_pos == m_end)
+				break;
+
+			switch (*m_pos++)
+			{
+			case '"': decoded += '"'; break;
+			case '\\': decoded += '\\'; break;
+			case '/': decoded += '/'; break;
+			case 'b': decoded += '\b'; break;
+			case 'f': decoded += '\f'; break;
+			case 'n': decoded += '\n'; break;
+			case 'r': decoded += '\r'; break;
+			case 't': decoded += '\t'; break;
+			case 'u':
+			{
+				uint32_t codepoint;
+
+				if (!parseHex4(codepoint))
+					return false;
+
+				// Surrogate pair, the low half has to follow right away
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF && m_end - m_pos >= 6 && m_pos[0] == '\\' && m_pos[1] == 'u')
+				{
+					const char *save = m_pos;
+					uint32_t low;
+					m_pos += 2;
+
+					if (parseHex4(low) && low >= 0xDC00 && low <= 0xDFFF)
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+					else
+						m_pos = save;
+				}
+
+				appendUtf8(decoded, codepoint);
+				break;
+			}
+			default: return fail("invalid escape character");
+			}
+		}
+
+		return fail("unexpected end of input in string");
+	}
+
+	bool parseNumber(JsonNode &out_node)
+	{
+		const char *start = m_pos;
+
+		// Validated against json's grammar first, from_chars alone would take "1." or "0x1"
+		if (m_pos < m_end && *m_pos == '-')
+			++m_pos;
+
+		if (m_pos < m_end && *m_pos == '0')
+		{
+			++m_pos;
+		}
+		else if (m_pos < m_end && *m_pos >= '1' && *m_pos <= '9')
+		{
+			while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9')
+				++m_pos;
+		}
+		else
+		{
+			return fail("invalid number");
+		}
+
+		if (m_pos < m_end && *m_pos == '.')
+		{
+			const char *digits = ++m_pos;
+
+			while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9')
+				++m_pos;
+
+			if (m_pos == digits)
+				return fail("at least one digit required in fractional part");
+		}
+
+		if (m_pos < m_end && (*m_pos == 'e' || *m_pos == 'E'))
+		{
+			++m_pos;
+
+			if (m_pos < m_end && (*m_pos == '+' || *m_pos == '-'))
+				++m_pos;
+
+			const char *digits = m_pos;
+
+			while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9')
+				++m_pos;
+
+			if (m_pos == digits)
+				return fail("at least one digit required in exponent");
+		}
+
+		out_node.m_type = JsonNode::NUMBER;
+		out_node.m_number = 0;
+		std::from_chars(start, m_pos, out_node.m_number);
+		return true;
+	}
+
+	bool parseValue(JsonNode &out_node, const int depth)
+	{
+		if (depth > kMaxDepth)
+			return fail("exceeded maximum nesting depth");
+
+		if (m_pos == m_end)
+			return fail("unexpected end of input");
+
+		const char *start = m_pos;
+		bool ok = true;
+
+		switch (*m_pos)
+		{
+		case 'n':
+			out_node.m_type = JsonNode::NUL;
+			ok = consume("null") || fail("expected null");
+			break;
+		case 't':
+		case 'f':
+			out_node.m_type = JsonNode::BOOL;
+			out_node.m_bool = *m_pos == 't';
+			ok = consume(out_node.m_bool ? "true" : "false") || fail("expected true or false");
+			break;
+		case '"':
+		{
+			std::string_view value;
+			ok = parseString(value);
+			out_node.m_type = JsonNode::STRING;
+			out_node.m_string = value.data();
+			out_node.m_size = value.size();
+			break;
+		}
+		case '[': ok = parseArray(out_node, depth); break;
+		case '{': ok = parseObject(out_node, depth); break;
+		default: ok = parseNumber(out_node); break;
+		}
+
+		out_node.m_raw = start;
+		out_node.m_rawSize = m_pos - start;
+		return ok;
+	}
+
+	// Children go on a shared stack while the container is open and move to the arena in one piece when it closes
+	bool parseArray(JsonNode &out_node, const int depth)
+	{
+		const size_t first = m_items.size();
+		++m_pos;
+		skipWhitespace();
+
+		if (m_pos < m_end && *m_pos == ']')
+		{
+			++m_pos;
+		}
+		else
+		{
+			for (;;)
+			{
+				JsonNode item;
+
+				if (!parseValue(item, depth + 1))
+					return false;
+
+				m_items.push_back(item);
+				skipWhitespace();
+
+				if (m_pos < m_end && *m_pos == ',')
+				{
+					++m_pos;
+					skipWhitespace();
+					continue;
+				}
+
+				if (m_pos < m_end && *m_pos == ']')
+				{
+					++m_pos;
+					break;
+				}
+
+				return fail("expected ',' or ']' in list, got " + describe());
+			}
+		}
+
+		out_node.m_type = JsonNode::ARRAY;
+		out_node.m_size = m_items.size() - first;
+		out_node.m_items = copyToArena(m_items.data() + first, out_node.m_size);
+		m_items.resize(first);
+		return true;
+	}
+
+	bool parseObject(JsonNode &out_node, const int depth)
+	{
+		const size_t first = m_members.size();
+		++m_pos;
+		skipWhitespace();
+
+		if (m_pos < m_end && *m_pos == '}')
+		{
+			++m_pos;
+		}
+		else
+		{
+			for (;;)
+			{
+				JsonNode::Member member;
+
+				if (m_pos == m_end || *m_pos != '"')
+					return fail("expected '\"' in object, got " + describe());
+
+				if (!parseString(member.key))
+					return false;
+
+				member.keyHash = JsonKey::hashOf(member.key);
+
+				skipWhitespace();
+
+				if (m_pos == m_end || *m_pos != ':')
+					return fail("expected ':' in object, got " + describe());
+
+				++m_pos;
+				skipWhitespace();
+
+				if (!parseValue(member.value, depth + 1))
+					return false;
+
+				m_members.push_back(member);
+				skipWhitespace();
+
+				if (m_pos < m_end && *m_pos == ',')
+				{
+					++m_pos;
+					skipWhitespace();
+					continue;
+				}
+
+				if (m_pos < m_end && *m_pos == '}')
+				{
+					++m_pos;
+					break;
+				}
+
+				return fail("expected ',' or '}' in object, got " + describe());
+			}
+		}
+
+		out_node.m_type = JsonNode::OBJECT;
+		out_node.m_size = m_members.size() - first;
+		out_node.m_members = copyToArena(m_members.data() + first, out_node.m_size);
+		m_members.resize(first);
+		return true;
+	}
+
+	std::vector<Block> m_blocks;
+	size_t m_used = 0;
+
+	JsonNode m_root;
+	std::vector<JsonNode> m_items;
+	std::vector<JsonNode::Member> m_members;
+	std::string m_scratch;
+
+	const char *m_pos = nullptr;
+	const char *m_end = nullptr;
+	std::string m_err;
+};
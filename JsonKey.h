@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/***
+* Object member names known at compile time, interned once instead of handled per use
+*	The hash and whether the name needs escaping are worked out when the constant is built
+*	JsonDocument compares hashes before bytes, JsonWriter writes a plain name without scanning it
+*/
+
+class JsonKey
+{
+public:
+	constexpr explicit JsonKey(const std::string_view name) : m_name(name), m_hash(hashOf(name)), m_plain(isPlain(name)) {}
+
+	constexpr std::string_view name() const { return m_name; }
+	constexpr uint32_t hash() const { return m_hash; }
+	constexpr bool plain() const { return m_plain; }
+
+	// FNV-1a, JsonDocument hashes the keys it parses the same way
+	static constexpr uint32_t hashOf(const std::string_view name)
+	{
+		uint32_t value = 2166136261u;
+
+		for (const char c : name)
+			value = (value ^ uint8_t(c)) * 16777619u;
+
+		return value;
+	}
+
+private:
+	// Anything JsonWriter would escape, non ascii included for U+2028 and U+2029
+	static constexpr bool isPlain(const std::string_view name)
+	{
+		for (const char c : name)
+		{
+			if (c == '"' || c == '\\' || uint8_t(c) < 0x20 || uint8_t(c) >= 0x80)
+				return false;
+		}
+
+		return true;
+	}
+
+	std::string_view m_name;
+	uint32_t m_hash = 0;
+	bool m_plain = false;
+};
+
+// Members most replies are made of
+namespace JsonKeys
+{
+	static constexpr JsonKey kError{"error"};
+	static constexpr JsonKey kStatus{"status"};
+	static constexpr JsonKey kSuccess{"success"};
+	static constexpr JsonKey kName{"name"};
+	static constexpr JsonKey kPath{"path"};
+	static constexpr JsonKey kValue{"value"};
+	static constexpr JsonKey kX{"x"};
+	static constexpr JsonKey kY{"y"};
+	static constexpr JsonKey kWidth{"width"};
+	static constexpr JsonKey kHeight{"height"};
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "JsonKey.h"
+
+/***
+* Forward only json writer, values are appended to the output as they're produced
+*	For results built while enumerating (obs_enum_sources and friends), no Json::object per item and no dump() of the whole list at the end
+*	Nesting is tracked with one bit per level, the caller keeps begin/end balanced
+*/
+
+class JsonWriter
+{
+public:
+	// Appends to 'out', whatever it already holds stays in front
+	explicit JsonWriter(std::string &out) : m_out(out) {}
+
+	JsonWriter(const JsonWriter &) = delete;
+	JsonWriter &operator=(const JsonWriter &) = delete;
+
+	JsonWriter &beginArray() { return open('['); }
+	JsonWriter &endArray() { return close(']'); }
+	JsonWriter &beginObject() { return open('{'); }
+	JsonWriter &endObject() { return close('}'); }
+
+	// Object member name, the next call writes its value
+	JsonWriter &key(const std::string_view name)
+	{
+		separate();
+		appendString(name);
+		m_out += ':';
+		m_afterKey = true;
+		return *this;
+	}
+
+	JsonWriter &key(const JsonKey &name)
+	{
+		if (!name.plain())
+			return key(name.name());
+
+		separate();
+		m_out += '"';
+		m_out += name.name();
+		m_out += "\":";
+		m_afterKey = true;
+		return *this;
+	}
+
+	JsonWriter &value(const std::string_view text)
+	{
+		separate();
+		appendString(text);
+		return *this;
+	}
+
+	// libobs hands out null for missing names, same as an empty string for the page
+	JsonWriter &value(const char *text) { return value(std::string_view(text ? text : "")); }
+	JsonWriter &value(const std::string &text) { return value(std::string_view(text)); }
+
+	JsonWriter &value(const bool flag)
+	{
+		separate();
+		m_out += flag ? "true" : "false";
+		return *this;
+	}
+
+	JsonWriter &value(const int number) { return integer(number); }
+
+	// uint32_t, size_t, int64_t and the like, int stays its own overload so enums still pick it
+	template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, int>, int> = 0>
+	JsonWriter &value(const T number)
+	{
+		return integer(number);
+	}
+
+	JsonWriter &value(const double number)
+	{
+		separate();
+
+		// Same as json11, there's no json for inf or nan
+		if (!std::isfinite(number))
+		{
+			m_out += "null";
+			return *this;
+		}
+
+		char buf[32];
+		m_out.append(buf, std::to_chars(buf, buf + sizeof(buf), number).ptr);
+		return *this;
+	}
+
+	JsonWriter &value(std::nullptr_t)
+	{
+		separate();
+		m_out += "null";
+		return *this;
+	}
+
+	// Already serialized json (obs_data_get_json and the like) goes in verbatim instead of as an escaped string, the caller vouches it's valid
+	JsonWriter &raw(const std::string_view json)
+	{
+		separate();
+		m_out += json.empty() ? std::string_view("null") : json;
+		return *this;
+	}
+
+	// Shorthand for one member
+	template<typename T> JsonWriter &member(const std::string_view name, const T &memberValue) { return key(name).value(memberValue); }
+	template<typename T> JsonWriter &member(const JsonKey &name, const T &memberValue) { return key(name).value(memberValue); }
+
+	// Most replies are one member, {"error": ...} or {"status": "success"}
+	template<typename T> static std::string object(const JsonKey &name, const T &memberValue)
+	{
+		std::string out;
+		JsonWriter(out).beginObject().member(name, memberValue).endObject();
+		return out;
+	}
+
+	template<typename T> static std::string object(const std::string_view name, const T &memberValue)
+	{
+		std::string out;
+		JsonWriter(out).beginObject().member(name, memberValue).endObject();
+		return out;
+	}
+
+private:
+	template<typename T> JsonWriter &integer(const T number)
+	{
+		separate();
+		char buf[24];
+		m_out.append(buf, std::to_chars(buf, buf + sizeof(buf), number).ptr);
+		return *this;
+	}
+
+	JsonWriter &open(const char bracket)
+	{
+		separate();
+		m_out += bracket;
+
+		// Nothing written at this level yet
+		++m_depth;
+		setHasItems(false);
+		return *this;
+	}
+
+	JsonWriter &close(const char bracket)
+	{
+		m_out += bracket;
+		--m_depth;
+		return *this;
+	}
+
+	void separate()
+	{
+		if (m_afterKey)
+		{
+			m_afterKey = false;
+			return;
+		}
+
+		if (m_depth > 0 && hasItems())
+			m_out += ',';
+
+		setHasItems(true);
+	}
+
+	bool hasItems() const { return m_depth < 64 ? (m_hasItems >> m_depth) & 1 : true; }
+
+	void setHasItems(const bool hasItems)
+	{
+		if (m_depth < 64)
+			m_hasItems = hasItems ? m_hasItems | (uint64_t(1) << m_depth) : m_hasItems & ~(uint64_t(1) << m_depth);
+	}
+
+	// Escapes like json11's dump() so the page sees the same strings, plain runs are appended in one go
+	void appendString(const std::string_view text)
+	{
+		static const char hex[] = "0123456789abcdef";
+
+		m_out += '"';
+		size_t run = 0;
+
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			const uint8_t ch = static_cast<uint8_t>(text[i]);
+			const char *escape = nullptr;
+			char unicode[7];
+
+			if (ch == '"')
+				escape = "\\\"";
+			else if (ch == '\\')
+				escape = "\\\\";
+			else if (ch == '\b')
+				escape = "\\b";
+			else if (ch == '\f')
+				escape = "\\f";
+			else if (ch == '\n')
+				escape = "\\n";
+			else if (ch == '\r')
+				escape = "\\r";
+			else if (ch == '\t')
+				escape = "\\t";
+			else if (ch <= 0x1f)
+			{
+				unicode[0] = '\\';
+				unicode[1] = 'u';
+				unicode[2] = '0';
+				unicode[3] = '0';
+				unicode[4] = hex[ch >> 4];
+				unicode[5] = hex[ch & 0xf];
+				unicode[6] = 0;
+				escape = unicode;
+			}
+			// U+2028 and U+2029 are fine in json but end a line in javascript source
+			else if (ch == 0xe2 && i + 2 < text.size() && uint8_t(text[i + 1]) == 0x80 && (uint8_t(text[i + 2]) == 0xa8 || uint8_t(text[i + 2]) == 0xa9))
+			{
+				m_out.append(text.data() + run, i - run);
+				m_out += uint8_t(text[i + 2]) == 0xa8 ? "\\u2028" : "\\u2029";
+				i += 2;
+				run = i + 1;
+				continue;
+			}
+			else
+				continue;
+
+			m_out.append(text.data() + run, i - run);
+			m_out += escape;
+			run = i + 1;
+		}
+
+		m_out.append(text.data() + run, text.size() - run);
+		m_out += '"';
+	}
+
+	std::string &m_out;
+	int m_depth = 0;
+	uint64_t m_hasItems = 0;
+	bool m_afterKey = false;
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/***
+* Multi producer, single consumer queue
+*	push never takes a lock (intrusive linked list, one exchange per push), the consumer sleeps on a condition variable when there's nothing to do
+*	Producers only touch the mutex to wake the consumer if it announced it's about to sleep
+*/
+
+template<typename T> class MpscQueue
+{
+public:
+	struct Stats
+	{
+		uint64_t pushed = 0;
+		uint64_t popped = 0;
+		uint64_t depth = 0;
+		uint64_t maxDepth = 0;
+		uint64_t totalWaitUs = 0;
+		uint64_t maxWaitUs = 0;
+	};
+
+	MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+	~MpscQueue()
+	{
+		T discard;
+
+		while (tryPop(discard)) {}
+	}
+
+	MpscQueue(const MpscQueue &) = delete;
+	MpscQueue &operator=(const MpscQueue &) = delete;
+
+	// Any thread
+	void push(T item)
+	{
+		Node *node = new Node{std::move(item), std::chrono::steady_clock::now()};
+
+		const uint64_t depth = m_depth.fetch_add(1) + 1;
+		m_pushed.fetch_add(1, std::memory_order_relaxed);
+		raise(m_maxDepth, depth);
+
+		link(node);
+
+		if (m_sleeping.load())
+		{
+			std::lock_guard<std::mutex> grd(m_wakeMtx);
+			m_wakeCv.notify_one();
+		}
+	}
+
+	// Consumer, false once closed
+	bool waitPop(T &out_item)
+	{
+		while (!m_closed.load())
+		{
+			if (tryPop(out_item))
+				return true;
+
+			std::unique_lock<std::mutex> lock(m_wakeMtx);
+			m_sleeping.store(true);
+
+			// A push between tryPop and here either sees m_sleeping or is seen by this check, depth goes up before the node is linked
+			if (m_depth.load() != 0 || m_closed.load())
+			{
+				m_sleeping.store(false);
+				continue;
+			}
+
+			m_wakeCv.wait(lock);
+			m_sleeping.store(false);
+		}
+
+		return false;
+	}
+
+	// Consumer
+	bool tryPop(T &out_item)
+	{
+		for (;;)
+		{
+			Node *tail = m_tail;
+			Node *next = tail->next.load(std::memory_order_acquire);
+
+			if (tail == &m_stub)
+			{
+				if (next == nullptr)
+					return false;
+
+				m_tail = next;
+				tail = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+
+			if (next != nullptr)
+			{
+				m_tail = next;
+				take(tail, out_item);
+				return true;
+			}
+
+			// Last node, the stub goes back behind it so it can be handed out
+			if (tail == m_head.load(std::memory_order_acquire))
+			{
+				link(&m_stub);
+				next = tail->next.load(std::memory_order_acquire);
+
+				if (next != nullptr)
+				{
+					m_tail = next;
+					take(tail, out_item);
+					return true;
+				}
+			}
+
+			// A producer swapped the head but hasn't linked its node yet, it's a few instructions away
+			std::this_thread::yield();
+		}
+	}
+
+	// Wakes the consumer for good
+	void close()
+	{
+		m_closed.store(true);
+
+		std::lock_guard<std::mutex> grd(m_wakeMtx);
+		m_wakeCv.notify_all();
+	}
+
+	Stats stats() const
+	{
+		Stats result;
+		result.pushed = m_pushed.load(std::memory_order_relaxed);
+		result.popped = m_popped.load(std::memory_order_relaxed);
+		result.depth = m_depth.load(std::memory_order_relaxed);
+		result.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+		result.totalWaitUs = m_totalWaitUs.load(std::memory_order_relaxed);
+		result.maxWaitUs = m_maxWaitUs.load(std::memory_order_relaxed);
+		return result;
+	}
+
+private:
+	struct Node
+	{
+		T item;
+		std::chrono::steady_clock::time_point queuedAt;
+		std::atomic<Node *> next{nullptr};
+	};
+
+	static void raise(std::atomic<uint64_t> &value, const uint64_t candidate)
+	{
+		uint64_t current = value.load(std::memory_order_relaxed);
+
+		while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {}
+	}
+
+	void link(Node *node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	void take(Node *node, T &out_item)
+	{
+		using namespace std::chrono;
+
+		const uint64_t waitUs = duration_cast<microseconds>(steady_clock::now() - node->queuedAt).count();
+		m_totalWaitUs.fetch_add(waitUs, std::memory_order_relaxed);
+		raise(m_maxWaitUs, waitUs);
+
+		m_depth.fetch_sub(1);
+		m_popped.fetch_add(1, std::memory_order_relaxed);
+
+		out_item = std::move(node->item);
+		delete node;
+	}
+
+	// Producers
+	std::atomic<Node *> m_head;
+
+	// Consumer, m_stub is an empty node that keeps the list from ever being empty
+	Node *m_tail;
+	Node m_stub;
+
+	std::atomic<bool> m_closed{false};
+	std::atomic<bool> m_sleeping{false};
+	std::mutex m_wakeMtx;
+	std::condition_variable m_wakeCv;
+
+	std::atomic<uint64_t> m_pushed{0};
+	std::atomic<uint64_t> m_popped{0};
+	std::atomic<uint64_t> m_depth{0};
+	std::atomic<uint64_t> m_maxDepth{0};
+	std::atomic<uint64_t> m_totalWaitUs{0};
+	std::atomic<uint64_t> m_maxWaitUs{0};
+};
@@ -0,0 +1,497 @@
+#include "ObsEventChannel.h"
+#include "GrpcPlugin.h"
+#include "JsonWriter.h"
+
+#include <json11/json11.hpp>
+
+#include <algorithm>
+#include <utility>
+
+using namespace json11;
+
+static const char *const kClassNames[] = {"frontend", "sources", "sceneitems", "transitions"};
+
+static const char *frontendEventName(const obs_frontend_event event)
+{
+	switch (event)
+	{
+	case OBS_FRONTEND_EVENT_STREAMING_STARTING: return "streaming_starting";
+	case OBS_FRONTEND_EVENT_STREAMING_STARTED: return "streaming_started";
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPING: return "streaming_stopping";
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPED: return "streaming_stopped";
+	case OBS_FRONTEND_EVENT_RECORDING_STARTING: return "recording_starting";
+	case OBS_FRONTEND_EVENT_RECORDING_STARTED: return "recording_started";
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPING: return "recording_stopping";
+	case OBS_FRONTEND_EVENT_RECORDING_STOPPED: return "recording_stopped";
+	case OBS_FRONTEND_EVENT_RECORDING_PAUSED: return "recording_paused";
+	case OBS_FRONTEND_EVENT_RECORDING_UNPAUSED: return "recording_unpaused";
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTING: return "replay_buffer_starting";
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED: return "replay_buffer_started";
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPING: return "replay_buffer_stopping";
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPED: return "replay_buffer_stopped";
+	case OBS_FRONTEND_EVENT_REPLAY_BUFFER_SAVED: return "replay_buffer_saved";
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STARTED: return "virtualcam_started";
+	case OBS_FRONTEND_EVENT_VIRTUALCAM_STOPPED: return "virtualcam_stopped";
+	case OBS_FRONTEND_EVENT_SCENE_CHANGED: return "scene_changed";
+	case OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED: return "scene_list_changed";
+	case OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED: return "preview_scene_changed";
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING: return "scene_collection_changing";
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED: return "scene_collection_changed";
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_LIST_CHANGED: return "scene_collection_list_changed";
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP: return "scene_collection_cleanup";
+	case OBS_FRONTEND_EVENT_PROFILE_CHANGING: return "profile_changing";
+	case OBS_FRONTEND_EVENT_PROFILE_CHANGED: return "profile_changed";
+	case OBS_FRONTEND_EVENT_PROFILE_LIST_CHANGED: return "profile_list_changed";
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED: return "studio_mode_enabled";
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED: return "studio_mode_disabled";
+	case OBS_FRONTEND_EVENT_TRANSITION_CHANGED: return "transition_changed";
+	case OBS_FRONTEND_EVENT_TRANSITION_STOPPED: return "transition_stopped";
+	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED: return "transition_list_changed";
+	case OBS_FRONTEND_EVENT_TRANSITION_DURATION_CHANGED: return "transition_duration_changed";
+	case OBS_FRONTEND_EVENT_TBAR_VALUE_CHANGED: return "tbar_value_changed";
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING: return "finished_loading";
+	case OBS_FRONTEND_EVENT_EXIT: return "exit";
+	default: return nullptr;
+	}
+}
+
+static bool isTransitionEvent(const obs_frontend_event event)
+{
+	switch (event)
+	{
+	case OBS_FRONTEND_EVENT_TRANSITION_CHANGED:
+	case OBS_FRONTEND_EVENT_TRANSITION_STOPPED:
+	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED:
+	case OBS_FRONTEND_EVENT_TRANSITION_DURATION_CHANGED:
+	case OBS_FRONTEND_EVENT_TBAR_VALUE_CHANGED: return true;
+	default: return false;
+	}
+}
+
+void ObsEventChannel::start()
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (m_running)
+			return;
+
+		m_running = true;
+	}
+
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_connect(handler, "source_create", onSourceCreate, this);
+	signal_handler_connect(handler, "source_remove", onSourceRemove, this);
+	signal_handler_connect(handler, "source_destroy", onSourceDestroy, this);
+	signal_handler_connect(handler, "source_rename", onSourceRename, this);
+
+	obs_enum_scenes(
+		[](void *param, obs_source_t *source) -> bool {
+			if (obs_source_is_scene(source))
+				reinterpret_cast<ObsEventChannel *>(param)->connectScene(source);
+
+			return true;
+		},
+		this);
+
+	m_flushThread = std::thread(&ObsEventChannel::flushThread, this);
+}
+
+void ObsEventChannel::stop()
+{
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_disconnect(handler, "source_create", onSourceCreate, this);
+	signal_handler_disconnect(handler, "source_remove", onSourceRemove, this);
+	signal_handler_disconnect(handler, "source_destroy", onSourceDestroy, this);
+	signal_handler_disconnect(handler, "source_rename", onSourceRename, this);
+
+	std::unordered_set<obs_source_t *> scenes;
+
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		m_running = false;
+		m_subscriptions.clear();
+		m_missedFrames.clear();
+		m_wantedClasses = 0;
+		scenes.swap(m_connectedScenes);
+	}
+
+	m_cv.notify_all();
+
+	for (obs_source_t *source : scenes)
+	{
+		signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+		signal_handler_disconnect(sceneHandler, "item_add", onItemAdd, this);
+		signal_handler_disconnect(sceneHandler, "item_remove", onItemRemove, this);
+		signal_handler_disconnect(sceneHandler, "item_transform", onItemTransform, this);
+	}
+
+	if (m_flushThread.joinable())
+		m_flushThread.join();
+}
+
+std::string ObsEventChannel::subscribe(const int browserId, const uint32_t navigation, const int funcId, const std::string &classes)
+{
+	std::string err;
+	Json parsed = Json::parse(classes, err);
+
+	if (!err.empty() || !parsed.is_array())
+		return JsonWriter::object(JsonKeys::kError, "Invalid params");
+
+	uint32_t mask = 0;
+	std::vector<std::string_view> names;
+
+	for (const Json &itr : parsed.array_items())
+	{
+		auto name = std::find(std::begin(kClassNames), std::end(kClassNames), itr.string_value());
+
+		if (name == std::end(kClassNames))
+			return JsonWriter::object(JsonKeys::kError, "Unknown event class " + itr.dump());
+
+		mask |= 1u << (name - std::begin(kClassNames));
+		names.push_back(*name);
+	}
+
+	// Without a callback there's nowhere to push to
+	if (funcId <= 0 && mask != 0)
+		return JsonWriter::object(JsonKeys::kError, "Subscribing needs a callback");
+
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		auto existing = m_subscriptions.find(browserId);
+
+		// The page that made this call is already gone, the browser's current one keeps its subscription
+		if (existing != m_subscriptions.end() && existing->second.navigation > navigation)
+			return JsonWriter::object(JsonKeys::kError, "Page navigated away");
+
+		if (mask == 0)
+			m_subscriptions.erase(browserId);
+		else
+			m_subscriptions[browserId] = {funcId, mask, navigation};
+
+		m_missedFrames.erase(browserId);
+
+		updateWantedClasses();
+	}
+
+	std::string out_jsonReturn;
+	JsonWriter writer(out_jsonReturn);
+	writer.beginObject().key("subscribed").beginArray();
+
+	for (const std::string_view name : names)
+		writer.value(name);
+
+	writer.endArray().endObject();
+	return out_jsonReturn;
+}
+
+void ObsEventChannel::unsubscribe(const int browserId, const uint32_t beforeNavigation)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	auto existing = m_subscriptions.find(browserId);
+
+	if (existing == m_subscriptions.end() || existing->second.navigation >= beforeNavigation)
+		return;
+
+	m_subscriptions.erase(existing);
+	m_missedFrames.erase(browserId);
+	updateWantedClasses();
+}
+
+void ObsEventChannel::onStreamAttached()
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+
+	if (m_missedFrames.empty())
+		return;
+
+	m_streamAttached = true;
+	m_cv.notify_one();
+}
+
+void ObsEventChannel::updateWantedClasses()
+{
+	uint32_t wanted = 0;
+
+	for (const auto &itr : m_subscriptions)
+		wanted |= itr.second.classes;
+
+	m_wantedClasses = wanted;
+}
+
+void ObsEventChannel::onFrontendEvent(const obs_frontend_event event)
+{
+	const bool transition = isTransitionEvent(event);
+	const EventClass eventClass = transition ? CLASS_TRANSITIONS : CLASS_FRONTEND;
+
+	if ((m_wantedClasses & eventClass) == 0)
+		return;
+
+	// Newer frontends have events this one doesn't know by name
+	const char *name = frontendEventName(event);
+	const std::string type = name ? name : "frontend_" + std::to_string(int(event));
+
+	std::string json;
+	JsonWriter(json).beginObject().member("class", transition ? "transitions" : "frontend").member("type", type).endObject();
+
+	// A t-bar drag fires on every step, the page only needs where it ended up
+	queueEvent(eventClass, std::move(json), event == OBS_FRONTEND_EVENT_TBAR_VALUE_CHANGED ? type : "");
+}
+
+void ObsEventChannel::queueEvent(const EventClass eventClass, std::string json, const std::string &coalesceKey)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+
+	if (!m_running || m_overflowed)
+		return;
+
+	if (!coalesceKey.empty())
+	{
+		auto existing = m_pendingByKey.find(coalesceKey);
+
+		// Keeps its place in the order, with the newest values
+		if (existing != m_pendingByKey.end())
+		{
+			m_pending[existing->second].json = std::move(json);
+			return;
+		}
+	}
+
+	// Only the overflow notice goes out for this window
+	if (m_pending.size() >= kMaxPendingEvents)
+	{
+		m_overflowed = true;
+		m_pending.clear();
+		m_pendingByKey.clear();
+		return;
+	}
+
+	if (!coalesceKey.empty())
+		m_pendingByKey[coalesceKey] = m_pending.size();
+
+	m_pending.push_back({eventClass, std::move(json)});
+
+	if (m_pending.size() == 1)
+		m_cv.notify_one();
+}
+
+void ObsEventChannel::flushThread()
+{
+	std::unique_lock<std::mutex> lock(m_mtx);
+
+	while (m_running)
+	{
+		m_cv.wait(lock, [this]() { return !m_running || !m_pending.empty() || m_overflowed || m_streamAttached; });
+
+		if (!m_running)
+			break;
+
+		// The first event of a burst starts the window, the rest of the burst rides along with it
+		m_cv.wait_for(lock, kBatchWindow, [this]() { return !m_running; });
+
+		lock.unlock();
+		flush();
+		lock.lock();
+	}
+}
+
+void ObsEventChannel::flush()
+{
+	std::vector<PendingEvent> events;
+	std::map<int, Subscription> subscriptions;
+	std::set<int> missed;
+	bool overflowed = false;
+
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		events.swap(m_pending);
+		m_pendingByKey.clear();
+		overflowed = std::exchange(m_overflowed, false);
+		m_streamAttached = false;
+		subscriptions = m_subscriptions;
+		missed = m_missedFrames;
+	}
+
+	// One frame per page with only the classes it asked for
+	for (const auto &itr : subscriptions)
+	{
+		std::string json;
+		JsonWriter writer(json);
+		writer.beginObject().key("events").beginArray();
+
+		bool any = false;
+
+		if (overflowed || missed.count(itr.first) != 0)
+		{
+			writer.beginObject().member("class", "channel").member("type", "overflow").endObject();
+			any = true;
+		}
+
+		for (const PendingEvent &event : events)
+		{
+			if ((itr.second.classes & event.eventClass) == 0)
+				continue;
+
+			writer.raw(event.json);
+			any = true;
+		}
+
+		writer.endArray().endObject();
+
+		if (!any)
+			continue;
+
+		const bool sent = GrpcPlugin::instance().writeEvents(itr.second.funcId, itr.first, json);
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		// Dropped, the page re-reads everything once the proxy is back
+		if (sent)
+			m_missedFrames.erase(itr.first);
+		else if (m_missedFrames.insert(itr.first).second)
+			blog(LOG_WARNING, "ObsEventChannel: proxy is away, events for browser %d are dropped until it's back", itr.first);
+	}
+}
+
+void ObsEventChannel::connectScene(obs_source_t *source)
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (!m_running || !m_connectedScenes.insert(source).second)
+			return;
+	}
+
+	signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+	signal_handler_connect(sceneHandler, "item_add", onItemAdd, this);
+	signal_handler_connect(sceneHandler, "item_remove", onItemRemove, this);
+	signal_handler_connect(sceneHandler, "item_transform", onItemTransform, this);
+}
+
+void ObsEventChannel::disconnectScene(obs_source_t *source)
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (m_connectedScenes.erase(source) == 0)
+			return;
+	}
+
+	signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+	signal_handler_disconnect(sceneHandler, "item_add", onItemAdd, this);
+	signal_handler_disconnect(sceneHandler, "item_remove", onItemRemove, this);
+	signal_handler_disconnect(sceneHandler, "item_transform", onItemTransform, this);
+}
+
+// Signal callbacks
+//
+
+static std::string sourceEventJson(const char *type, obs_source_t *source)
+{
+	std::string json;
+	JsonWriter(json).beginObject().member("class", "sources").member("type", type).member("name", obs_source_get_name(source)).member("kind", obs_source_get_id(source)).endObject();
+	return json;
+}
+
+static std::string itemEventJson(const char *type, calldata_t *cd)
+{
+	obs_scene_t *scene = static_cast<obs_scene_t *>(calldata_ptr(cd, "scene"));
+	obs_sceneitem_t *item = static_cast<obs_sceneitem_t *>(calldata_ptr(cd, "item"));
+
+	std::string json;
+	JsonWriter(json)
+		.beginObject()
+		.member("class", "sceneitems")
+		.member("type", type)
+		.member("scene", scene ? obs_source_get_name(obs_scene_get_source(scene)) : nullptr)
+		.member("item", item ? obs_source_get_name(obs_sceneitem_get_source(item)) : nullptr)
+		.member("id", item ? int(obs_sceneitem_get_id(item)) : 0)
+		.endObject();
+	return json;
+}
+
+/*static*/
+void ObsEventChannel::onSourceCreate(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source == nullptr)
+		return;
+
+	// Always, a scene created before anyone subscribed still has to report its items later
+	if (obs_source_is_scene(source))
+		self->connectScene(source);
+
+	if (self->m_wantedClasses & CLASS_SOURCES)
+		self->queueEvent(CLASS_SOURCES, sourceEventJson("source_create", source));
+}
+
+/*static*/
+void ObsEventChannel::onSourceRemove(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source != nullptr && (self->m_wantedClasses & CLASS_SOURCES))
+		self->queueEvent(CLASS_SOURCES, sourceEventJson("source_remove", source));
+}
+
+/*static*/
+void ObsEventChannel::onSourceDestroy(void *data, calldata_t *cd)
+{
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source != nullptr && obs_source_is_scene(source))
+		static_cast<ObsEventChannel *>(data)->disconnectScene(source);
+}
+
+/*static*/
+void ObsEventChannel::onSourceRename(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+
+	if ((self->m_wantedClasses & CLASS_SOURCES) == 0)
+		return;
+
+	std::string json;
+	JsonWriter(json)
+		.beginObject()
+		.member("class", "sources")
+		.member("type", "source_rename")
+		.member("name", calldata_string(cd, "new_name"))
+		.member("prev", calldata_string(cd, "prev_name"))
+		.endObject();
+
+	self->queueEvent(CLASS_SOURCES, std::move(json));
+}
+
+/*static*/
+void ObsEventChannel::onItemAdd(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+
+	if (self->m_wantedClasses & CLASS_SCENEITEMS)
+		self->queueEvent(CLASS_SCENEITEMS, itemEventJson("item_add", cd));
+}
+
+/*static*/
+void ObsEventChannel::onItemRemove(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+
+	if (self->m_wantedClasses & CLASS_SCENEITEMS)
+		self->queueEvent(CLASS_SCENEITEMS, itemEventJson("item_remove", cd));
+}
+
+/*static*/
+void ObsEventChannel::onItemTransform(void *data, calldata_t *cd)
+{
+	ObsEventChannel *self = static_cast<ObsEventChannel *>(data);
+
+	if ((self->m_wantedClasses & CLASS_SCENEITEMS) == 0)
+		return;
+
+	// Fires every video frame while an item is dragged, one per item per window is enough
+	obs_sceneitem_t *item = static_cast<obs_sceneitem_t *>(calldata_ptr(cd, "item"));
+	self->queueEvent(CLASS_SCENEITEMS, itemEventJson("item_transform", cd), "item_transform:" + std::to_string(uintptr_t(item)));
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <obs.h>
+#include <obs-frontend-api.h>
+
+/***
+* Pushes OBS events to pages that subscribed to them, instead of the page polling for changes
+*	A page subscribes its callback to event classes, the callback then gets { "events": [...] } frames on the js stream until it subscribes again or goes away
+*	Events are collected for kBatchWindow and sent as one frame per page, repeats of the same transform in that window are sent once
+*	Signal and frontend callbacks only queue, the frames are built and sent on the channel's own thread
+*/
+
+class ObsEventChannel
+{
+public:
+	static ObsEventChannel &instance()
+	{
+		static ObsEventChannel a;
+		return a;
+	}
+
+	enum EventClass : uint32_t
+	{
+		CLASS_FRONTEND = 1 << 0,
+		CLASS_SOURCES = 1 << 1,
+		CLASS_SCENEITEMS = 1 << 2,
+		CLASS_TRANSITIONS = 1 << 3,
+	};
+
+	void start();
+	void stop();
+
+	// 'classes' is a json array of "frontend", "sources", "sceneitems", "transitions", an empty one unsubscribes
+	//	One subscription per browser, a new one replaces the last unless it's from an older navigation. Returns the reply for the subscribe call
+	std::string subscribe(const int browserId, const uint32_t navigation, const int funcId, const std::string &classes);
+	// Only a subscription made before 'beforeNavigation' is dropped, a late cancel leaves the new page's alone
+	void unsubscribe(const int browserId, const uint32_t beforeNavigation);
+
+	// Any thread
+	void onFrontendEvent(const obs_frontend_event event);
+
+	// Frames aren't held while the proxy is away, pages that missed some are sent the overflow notice once it's back
+	void onStreamAttached();
+
+private:
+	ObsEventChannel() = default;
+
+	struct PendingEvent
+	{
+		EventClass eventClass;
+		std::string json;
+	};
+
+	// 'coalesceKey' non empty replaces a queued event with the same key instead of adding another
+	void queueEvent(const EventClass eventClass, std::string json, const std::string &coalesceKey = "");
+	void flushThread();
+	void flush();
+	// Called with m_mtx held
+	void updateWantedClasses();
+
+	void connectScene(obs_source_t *source);
+	void disconnectScene(obs_source_t *source);
+
+	static void onSourceCreate(void *data, calldata_t *cd);
+	static void onSourceRemove(void *data, calldata_t *cd);
+	static void onSourceDestroy(void *data, calldata_t *cd);
+	static void onSourceRename(void *data, calldata_t *cd);
+	static void onItemAdd(void *data, calldata_t *cd);
+	static void onItemRemove(void *data, calldata_t *cd);
+	static void onItemTransform(void *data, calldata_t *cd);
+
+	// Long enough that a drag sends a couple of frames a second per item instead of one per video frame, short enough for a scene switch to feel immediate
+	static constexpr std::chrono::milliseconds kBatchWindow{50};
+
+	// Past this many in one window the page is told to re-read everything instead
+	static constexpr size_t kMaxPendingEvents = 4096;
+
+	struct Subscription
+	{
+		int funcId = 0;
+		uint32_t classes = 0;
+		uint32_t navigation = 0;
+	};
+
+	std::mutex m_mtx;
+	std::condition_variable m_cv;
+	std::map<int, Subscription> m_subscriptions;
+	std::vector<PendingEvent> m_pending;
+	std::unordered_map<std::string, size_t> m_pendingByKey;
+	bool m_overflowed = false;
+	// Browsers owed an overflow notice because a frame of theirs was dropped
+	std::set<int> m_missedFrames;
+	bool m_streamAttached = false;
+	std::unordered_set<obs_source_t *> m_connectedScenes;
+
+	// Union of what's subscribed, callbacks return early without the lock when nobody wants their class
+	std::atomic<uint32_t> m_wantedClasses = 0;
+	bool m_running = false;
+	std::thread m_flushThread;
+};
@@ -0,0 +1,138 @@
+#include "ObsReadCache.h"
+
+#include <util/config-file.h>
+
+static const char *const kEntryNames[ObsReadCache::ENTRY_COUNT] = {"current scene", "scene collections", "stream settings", "scenes"};
+
+// Global signals that change the list of scenes or their names
+static const char *const kSourceSignals[] = {"source_create", "source_destroy", "source_remove", "source_rename"};
+
+void ObsReadCache::start()
+{
+	// Overridable in the global config, [SlabsBrowser]
+	config_t *config = obs_frontend_get_global_config();
+	config_set_default_bool(config, "SlabsBrowser", "ReadCacheCrossCheck", false);
+	m_crossCheck = config_get_bool(config, "SlabsBrowser", "ReadCacheCrossCheck");
+
+	signal_handler_t *handler = obs_get_signal_handler();
+
+	for (const char *signal : kSourceSignals)
+		signal_handler_connect(handler, signal, onSceneListChanged, this);
+}
+
+void ObsReadCache::stop()
+{
+	signal_handler_t *handler = obs_get_signal_handler();
+
+	for (const char *signal : kSourceSignals)
+		signal_handler_disconnect(handler, signal, onSceneListChanged, this);
+
+	blog(LOG_INFO, "ObsReadCache: %llu hits, %llu misses, %llu cross check mismatches", m_hits.load(), m_misses.load(), m_mismatches.load());
+}
+
+bool ObsReadCache::lookup(const Entry entry, std::string &out_json, uint64_t &out_generation)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	Slot &slot = m_slots[entry];
+	out_generation = slot.generation;
+
+	if (slot.valid && kMaxAge[entry].count() != 0 && std::chrono::steady_clock::now() - slot.storedAt > kMaxAge[entry])
+		slot.valid = false;
+
+	if (!slot.valid)
+	{
+		++m_misses;
+		return false;
+	}
+
+	++m_hits;
+	out_json = slot.json;
+	return true;
+}
+
+void ObsReadCache::store(const Entry entry, const uint64_t generation, const std::string &json)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	Slot &slot = m_slots[entry];
+
+	// Invalidated while the query ran, what it read may already be stale
+	if (slot.generation != generation)
+		return;
+
+	// Errors are about the moment they happened (no current scene while a collection loads), not kept
+	if (json.rfind("{\"error\"", 0) == 0)
+		return;
+
+	slot.json = json;
+	slot.valid = true;
+	slot.storedAt = std::chrono::steady_clock::now();
+}
+
+void ObsReadCache::invalidate(const Entry entry)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	m_slots[entry].valid = false;
+	++m_slots[entry].generation;
+}
+
+void ObsReadCache::crossCheck(const Entry entry, const uint64_t generation, const std::string &cached, const std::string &live)
+{
+	if (cached == live)
+		return;
+
+	// Changed while the live query ran, that's the cache doing its job
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (m_slots[entry].generation != generation)
+			return;
+	}
+
+	++m_mismatches;
+	blog(LOG_WARNING, "ObsReadCache: cached %s is stale, cached %s, live %s", kEntryNames[entry], cached.c_str(), live.c_str());
+
+	// The live one is what the page got, the cache catches up with it
+	invalidate(entry);
+}
+
+void ObsReadCache::onFrontendEvent(const obs_frontend_event event)
+{
+	switch (event)
+	{
+	case OBS_FRONTEND_EVENT_SCENE_CHANGED:
+		invalidate(CURRENT_SCENE);
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP:
+		invalidate(CURRENT_SCENE);
+		invalidate(SCENES);
+		invalidate(SCENE_COLLECTIONS);
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_LIST_CHANGED:
+		invalidate(SCENE_COLLECTIONS);
+		break;
+	case OBS_FRONTEND_EVENT_PROFILE_CHANGED:
+		invalidate(STREAM_SETTINGS);
+		break;
+	case OBS_FRONTEND_EVENT_EXIT:
+		for (int entry = 0; entry < ENTRY_COUNT; ++entry)
+			invalidate(Entry(entry));
+		break;
+	default:
+		break;
+	}
+}
+
+/*static*/
+void ObsReadCache::onSceneListChanged(void *data, calldata_t *cd)
+{
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source == nullptr || obs_source_get_type(source) != OBS_SOURCE_TYPE_SCENE)
+		return;
+
+	// The current scene's reply is its name, a rename changes it without a scene switch
+	ObsReadCache *self = static_cast<ObsReadCache *>(data);
+	self->invalidate(SCENES);
+	self->invalidate(CURRENT_SCENE);
+}
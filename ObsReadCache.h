@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <obs.h>
+#include <obs-frontend-api.h>
+
+/***
+* Replies to read only queries the page polls, kept until a libobs or frontend signal says they changed
+*	A hit is answered on the lane worker without a Qt hop, a miss runs the query as before and stores its reply
+*	Each entry has a generation, a reply computed across an invalidation is not stored
+*	With [SlabsBrowser] ReadCacheCrossCheck=true every hit is also run live and compared, mismatches are logged
+*/
+
+class ObsReadCache
+{
+public:
+	static ObsReadCache &instance()
+	{
+		static ObsReadCache a;
+		return a;
+	}
+
+	enum Entry
+	{
+		CURRENT_SCENE,
+		SCENE_COLLECTIONS,
+		STREAM_SETTINGS,
+		SCENES,
+		ENTRY_COUNT
+	};
+
+	void start();
+	void stop();
+
+	// False on a miss. 'out_generation' goes back to store() with the live reply
+	bool lookup(const Entry entry, std::string &out_json, uint64_t &out_generation);
+	void store(const Entry entry, const uint64_t generation, const std::string &json);
+	void invalidate(const Entry entry);
+
+	// Hits should still be run live and handed to crossCheck()
+	bool crossChecking() const { return m_crossCheck; }
+	void crossCheck(const Entry entry, const uint64_t generation, const std::string &cached, const std::string &live);
+
+	// Any thread
+	void onFrontendEvent(const obs_frontend_event event);
+
+private:
+	ObsReadCache() = default;
+
+	static void onSceneListChanged(void *data, calldata_t *cd);
+
+	struct Slot
+	{
+		std::string json;
+		bool valid = false;
+		uint64_t generation = 0;
+		std::chrono::steady_clock::time_point storedAt;
+	};
+
+	// Stream settings change in the settings dialog without a signal, that entry also expires on its own
+	static constexpr std::chrono::milliseconds kMaxAge[ENTRY_COUNT] = {std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(2000), std::chrono::milliseconds(0)};
+
+	std::mutex m_mtx;
+	std::array<Slot, ENTRY_COUNT> m_slots;
+	bool m_crossCheck = false;
+
+	std::atomic<uint64_t> m_hits = 0;
+	std::atomic<uint64_t> m_misses = 0;
+	std::atomic<uint64_t> m_mismatches = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <string>
+
+/***
+* Chunked results, plugin -> proxy -> renderer
+*	Results too big for the shared ring or one grpc message are cut into fixed size chunks, each deflated on its own
+*	The proxy inflates and forwards every chunk as it arrives, it never holds the whole result
+*/
+
+namespace PayloadChunks
+{
+	// Below this the shared ring or an inline reply is cheaper
+	static constexpr size_t kThreshold = 1024 * 1024;
+	static constexpr size_t kChunkSize = 256 * 1024;
+
+	static bool compress(const char *data, const size_t length, std::string &out_compressed)
+	{
+		uLongf compressedLength = compressBound(uLong(length));
+		out_compressed.resize(compressedLength);
+
+		// Speed over ratio, this is local ipc
+		if (compress2(reinterpret_cast<Bytef *>(out_compressed.data()), &compressedLength, reinterpret_cast<const Bytef *>(data), uLong(length), Z_BEST_SPEED) != Z_OK)
+			return false;
+
+		out_compressed.resize(compressedLength);
+		return true;
+	}
+
+	static bool decompress(const std::string &compressed, const size_t rawLength, std::string &out_data)
+	{
+		if (rawLength > kChunkSize)
+			return false;
+
+		uLongf length = uLongf(rawLength);
+		out_data.resize(length);
+
+		if (uncompress(reinterpret_cast<Bytef *>(out_data.data()), &length, reinterpret_cast<const Bytef *>(compressed.data()), uLong(compressed.size())) != Z_OK)
+			return false;
+
+		return length == rawLength;
+	}
+}
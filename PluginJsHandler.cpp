@@ -3,6 +3,12 @@
 
 // Local
 #include "JavascriptApi.h"
+#include "JavascriptApiArgs.h"
+#include "Utf8Path.h"
+#include "JsonWriter.h"
+#include "ObsEventChannel.h"
+#include "ObsReadCache.h"
+#include "SceneGraph.h"
 #include "GrpcPlugin.h"
 #include "WebServer.h"
 #include "WindowsFunctions.h"
@@ -14,8 +20,12 @@
 #include <Psapi.h>
 
 // Stl
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <codecvt>
 
 // Obs
@@ -36,6 +46,14 @@
 
 using namespace json11;
 
+// Which lane the calling worker serves, a handler hopping to Qt comes back to it
+static thread_local JavascriptApi::Lane t_currentLane = JavascriptApi::LANE_UI;
+
+// Who made the call being dispatched on this worker, for handlers that keep answering after their reply (event subscriptions)
+static thread_local int t_currentBrowserId = 0;
+static thread_local int t_currentFuncId = 0;
+static thread_local uint32_t t_currentNavigation = 0;
+
 PluginJsHandler::PluginJsHandler() {}
 
 PluginJsHandler::~PluginJsHandler()
@@ -69,49 +87,295 @@ std::wstring PluginJsHandler::getFontsDir() const
 void PluginJsHandler::start()
 {
 	m_running = true;
-	m_workerThread = std::thread(&PluginJsHandler::workerThread, this);
+	loadQueueLimits();
+
+	for (int lane = 0; lane < JavascriptApi::LANE_COUNT; ++lane)
+		m_workerThreads[lane] = std::thread(&PluginJsHandler::workerThread, this, JavascriptApi::Lane(lane));
 	m_freezeCheckThread = std::thread(&PluginJsHandler::freezeCheckThread, this);
 }
 
 void PluginJsHandler::stop()
 {
 	m_running = false;
+	for (auto &itr : m_queudRequests)
+		itr.close();
 
-	if (m_workerThread.joinable())
-		m_workerThread.join();
+	for (auto &itr : m_workerThreads)
+	{
+		if (itr.joinable())
+			itr.join();
+	}
 
 	if (m_freezeCheckThread.joinable())
 		m_freezeCheckThread.join();
+
+	blog(LOG_INFO, "PluginJsHandler: %llu setter calls coalesced, %llu refused as busy", m_coalescedCount.load(), m_busyCount.load());
 }
 
-void PluginJsHandler::pushApiRequest(const std::string &funcName, const std::string &params)
+void PluginJsHandler::loadQueueLimits()
 {
-	std::lock_guard<std::mutex> grd(m_queueMtx);
-	m_queudRequests.push_back({funcName, params});
+	static const char *keys[JavascriptApi::PRIORITY_COUNT] = {"ApiQueueLimitInteractive", "ApiQueueLimitNormal", "ApiQueueLimitBulk"};
+
+	// Overridable in the global config, [SlabsBrowser]
+	config_t *config = obs_frontend_get_global_config();
+
+	for (int priority = 0; priority < JavascriptApi::PRIORITY_COUNT; ++priority)
+	{
+		config_set_default_uint(config, "SlabsBrowser", keys[priority], kDefaultQueueLimits[priority]);
+		m_queueLimits[priority] = config_get_uint(config, "SlabsBrowser", keys[priority]);
+	}
 }
 
-void PluginJsHandler::workerThread()
+// Param2 onward, the json path carries the callback id as its first element
+static bool decodeArgs(const grpc_js_api_Request &request, JsArgs &out_args, int &out_funcId)
 {
-	while (m_running)
+	if (request.apiid() != JavascriptApi::JS_INVALID)
 	{
-		std::vector<std::pair<std::string, std::string>> latestBatch;
+		// Typed arguments, nothing to parse
+		out_funcId = request.funcid();
+		return JavascriptApiArgs::decode(request.apiid(), request.args(), out_args);
+	}
 
-		{
-			std::lock_guard<std::mutex> grd(m_queueMtx);
-			latestBatch.swap(m_queudRequests);
-		}
+	std::string err;
+	JsonDocument parsed;
+
+	if (!parsed.parse(request.params(), err) || !parsed.root().is_array() || parsed.root().size() == 0)
+		return false;
+
+	const JsonNode &items = parsed.root();
+	out_funcId = items[0].int_value();
+
+	for (size_t i = 1; i < items.size(); ++i)
+		out_args.add(items[i]);
+
+	return true;
+}
+
+// Type tag then the value, "1" the string and 1 the number stay different targets
+static void appendCoalesceKeyPart(const JsArgs::Arg &arg, std::string &out_key)
+{
+	out_key += '\x1f';
+	out_key += char('0' + arg.type);
+
+	switch (arg.type)
+	{
+	case JsArgs::Arg::NUMBER:
+	{
+		char buffer[32];
+		const auto result = std::to_chars(buffer, buffer + sizeof(buffer), arg.number);
+		out_key.append(buffer, result.ptr);
+		break;
+	}
+	case JsArgs::Arg::BOOL: out_key += arg.flag ? '1' : '0'; break;
+	case JsArgs::Arg::STRING:
+	case JsArgs::Arg::JSON: out_key += arg.text; break;
+	default: break;
+	}
+}
+
+void PluginJsHandler::pushApiRequest(const grpc_js_api_Request &request, ApiCompletion onComplete)
+{
+	const JavascriptApi::JSFuncs apiId = request.apiid() != JavascriptApi::JS_INVALID ? JavascriptApi::JSFuncs(request.apiid()) : JavascriptApi::getFunctionId(request.funcname());
+
+	const JavascriptApi::Lane lane = JavascriptApi::getLane(apiId);
+	const JavascriptApi::Priority priority = JavascriptApi::getPriority(apiId);
+
+	// The lane is backed up past what this priority may add to, the page hears it right away instead of the queue growing without bound
+	//	Bulk is refused first, interactive calls still get in
+	if (m_laneOutstanding[lane].fetch_add(1) >= m_queueLimits[priority])
+	{
+		--m_laneOutstanding[lane];
+		++m_busyCount;
+		onComplete(request.funcid(), JsonWriter::object(JsonKeys::kError, "Busy"));
+		return;
+	}
+
+	// Counted until it's answered, handlers waiting on their Qt hop included
+	auto countedOnComplete = [this, lane, onComplete = std::move(onComplete)](const int funcId, const std::string &jsonReturn) {
+		--m_laneOutstanding[lane];
+		onComplete(funcId, jsonReturn);
+	};
+
+	ApiRequest itr{request, std::move(countedOnComplete)};
+	itr.priority = priority;
+
+	// Newer setter for the same target, whatever is still queued for it gets skipped
+	//	A bad one is left to fail when it runs
+	const int keyParams = JavascriptApi::getCoalesceKeyParams(apiId);
+
+	if (keyParams != 0 && decodeArgs(itr.request, itr.args, itr.funcId))
+	{
+		itr.argsDecoded = true;
+		itr.coalesceKey = getCoalesceKey(apiId, request.browserid(), itr.args, keyParams);
+
+		std::lock_guard<std::mutex> grd(m_coalesceMtx);
+		itr.coalesceSeq = ++m_coalesceSeq;
+		m_newestSetters[itr.coalesceKey] = itr.coalesceSeq;
+	}
 
-		if (latestBatch.empty())
+	// Called from grpc threads, only coalesced setters lock
+	m_queudRequests[lane].push(std::move(itr));
+}
+
+std::string PluginJsHandler::getCoalesceKey(const JavascriptApi::JSFuncs apiId, const int browserId, const JsArgs &args, const int keyParams)
+{
+	// Per page, a page that navigates away shouldn't take another page's last write with it
+	std::string key = std::to_string(apiId) + ":" + std::to_string(browserId);
+
+	for (int i = 0; i < keyParams; ++i)
+		appendCoalesceKeyPart(args[i], key);
+
+	return key;
+}
+
+bool PluginJsHandler::isSuperseded(const std::string &coalesceKey, const uint64_t coalesceSeq)
+{
+	if (coalesceKey.empty())
+		return false;
+
+	std::lock_guard<std::mutex> grd(m_coalesceMtx);
+	auto newest = m_newestSetters.find(coalesceKey);
+
+	if (newest == m_newestSetters.end())
+		return false;
+
+	if (newest->second != coalesceSeq)
+	{
+		++m_coalescedCount;
+		return true;
+	}
+
+	// Newest one is on its way, a push after this starts over
+	m_newestSetters.erase(newest);
+	return false;
+}
+
+void PluginJsHandler::pushResume(std::coroutine_handle<> handle, const JavascriptApi::Lane lane)
+{
+	ApiRequest itr;
+	itr.resume = handle;
+	m_queudRequests[lane].push(std::move(itr));
+}
+
+JsTask::QtHop PluginJsHandler::onQtThread(QObject *target, std::function<void()> func)
+{
+	const JavascriptApi::Lane lane = t_currentLane;
+	return {target, std::move(func), [this, lane](std::coroutine_handle<> handle) { pushResume(handle, lane); }};
+}
+
+JsTask::Hop PluginJsHandler::resumeOnLane(const JavascriptApi::Lane lane)
+{
+	return {[this, lane](std::coroutine_handle<> handle) { pushResume(handle, lane); }};
+}
+
+void PluginJsHandler::cancelRequests(const int browserId, const uint32_t navigation, const bool closed)
+{
+	std::lock_guard<std::mutex> grd(m_cancelMtx);
+
+	// Its event callback went with the page, under the lock so JS_OBS_SUBSCRIBE_EVENTS sees either both or neither
+	ObsEventChannel::instance().unsubscribe(browserId, closed ? UINT32_MAX : navigation);
+
+	if (closed)
+	{
+		m_cancelledBefore[browserId] = UINT32_MAX;
+		m_closedBrowsers.push_back(browserId);
+
+		if (m_closedBrowsers.size() > kMaxClosedBrowsers)
 		{
-			using namespace std::chrono;
-			std::this_thread::sleep_for(1ms);
+			m_cancelledBefore.erase(m_closedBrowsers.front());
+			m_closedBrowsers.pop_front();
 		}
-		else
+
+		return;
+	}
+
+	// Cancels arrive out of order with the stream, an older one doesn't undo a newer one
+	uint32_t &cancelledBefore = m_cancelledBefore[browserId];
+	cancelledBefore = std::max(cancelledBefore, navigation);
+}
+
+bool PluginJsHandler::isExpired(const ApiRequest &itr)
+{
+	using namespace std::chrono;
+
+	const uint64_t deadline = itr.request.deadline();
+
+	if (deadline != 0 && uint64_t(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) > deadline)
+		return true;
+
+	std::lock_guard<std::mutex> grd(m_cancelMtx);
+	auto cancelled = m_cancelledBefore.find(itr.request.browserid());
+	return cancelled != m_cancelledBefore.end() && itr.request.navigation() < cancelled->second;
+}
+
+void PluginJsHandler::workerThread(const JavascriptApi::Lane lane)
+{
+	ApiRequest itr;
+	t_currentLane = lane;
+
+	// Taken off the queue but not run yet, by priority, only this thread touches them
+	std::deque<ApiRequest> waiting[JavascriptApi::PRIORITY_COUNT];
+
+	for (;;)
+	{
+		// Whatever arrived meanwhile is sorted in first, a fresh scene switch goes ahead of housekeeping that was already waiting
+		while (m_queudRequests[lane].tryPop(itr))
+			waiting[itr.priority].push_back(std::move(itr));
+
+		auto next = std::find_if(std::begin(waiting), std::end(waiting), [](const std::deque<ApiRequest> &queue) { return !queue.empty(); });
+
+		if (next == std::end(waiting))
 		{
-			for (auto &itr : latestBatch)
-				executeApiRequest(itr.first, itr.second);
+			// Sleeps until there's work, no polling
+			if (!m_queudRequests[lane].waitPop(itr))
+				break;
+
+			waiting[itr.priority].push_back(std::move(itr));
+			continue;
 		}
+
+		itr = std::move(next->front());
+		next->pop_front();
+		runRequest(itr);
 	}
+
+	auto stats = m_queudRequests[lane].stats();
+	blog(LOG_INFO, "PluginJsHandler: lane %d, %llu requests, max queue depth %llu, wait avg %llu us, max %llu us", int(lane), stats.popped, stats.maxDepth, stats.popped != 0 ? stats.totalWaitUs / stats.popped : 0, stats.maxWaitUs);
+}
+
+void PluginJsHandler::runRequest(ApiRequest &itr)
+{
+	// A handler coming back from a hop, it was already let through and owes its caller a reply
+	if (itr.resume)
+	{
+		std::exchange(itr.resume, nullptr).resume();
+		return;
+	}
+
+	// A later call sets the same thing, answered so the page's callback still resolves
+	if (isSuperseded(itr.coalesceKey, itr.coalesceSeq))
+	{
+		itr.onComplete(itr.request.funcid(), JsonWriter::object("coalesced", true));
+		return;
+	}
+
+	// The page already gave up on it or navigated away, a stuck call ahead of it shouldn't make it run late
+	//	Replied to with no callback id so the reactor or stream still sees an answer
+	if (isExpired(itr))
+	{
+		blog(LOG_WARNING, "PluginJsHandler: skipping %s, its deadline passed or it was cancelled", itr.request.funcname().c_str());
+		itr.onComplete(0, JsonWriter::object(JsonKeys::kError, "Timed out"));
+		return;
+	}
+
+	if (itr.coalesceKey.empty())
+	{
+		executeApiRequest(itr.request, itr.onComplete);
+		return;
+	}
+
+	// Checked again when its Qt hop comes up, setters pile up in the Qt event queue more than here
+	executeApiRequest(itr.request, itr.args, itr.funcId, itr.onComplete, [this, coalesceKey = itr.coalesceKey, coalesceSeq = itr.coalesceSeq]() { return isSuperseded(coalesceKey, coalesceSeq); });
 }
 
 void PluginJsHandler::freezeCheckThread()
@@ -156,148 +420,305 @@ void PluginJsHandler::freezeCheckThread()
 	}
 }
 
-void PluginJsHandler::executeApiRequest(const std::string &funcName, const std::string &params)
+void PluginJsHandler::executeApiRequest(const grpc_js_api_Request &request, const ApiCompletion &onComplete, std::function<bool()> isSuperseded)
 {
-	std::string err;
-	Json jsonParams = Json::parse(params, err);
+	JsArgs args;
+	int funcId = 0;
 
-	if (!err.empty())
+	if (!decodeArgs(request, args, funcId))
 	{
-		blog(LOG_ERROR, "PluginJsHandler::executeApiRequest invalid params %s", params.c_str());
+		blog(LOG_ERROR, "PluginJsHandler::executeApiRequest invalid params for %s", request.funcname().c_str());
+		onComplete(funcId, JsonWriter::object(JsonKeys::kError, "Invalid params"));
 		return;
 	}
 
-	const auto &param1Value = jsonParams["param1"];
+	executeApiRequest(request, args, funcId, onComplete, std::move(isSuperseded));
+}
 
-	if (param1Value.is_null())
-	{
-		blog(LOG_ERROR, "PluginJsHandler::executeApiRequest Error: 'param1' key not found. %s", params.c_str());
-		return;
-	}
+void PluginJsHandler::executeApiRequest(const grpc_js_api_Request &request, JsArgs &args, const int funcId, const ApiCompletion &onComplete, std::function<bool()> isSuperseded)
+{
+	const std::string &funcName = request.funcname();
+	const JavascriptApi::JSFuncs apiId = request.apiid() != JavascriptApi::JS_INVALID ? JavascriptApi::JSFuncs(request.apiid()) : JavascriptApi::getFunctionId(funcName);
 
 #ifndef GITHUB_REVISION
-	blog(LOG_INFO, "executeApiRequest (start) %s: %s\n", funcName.c_str(), params.c_str());
+	blog(LOG_INFO, "executeApiRequest (start) %s: %zu args\n", funcName.c_str(), args.size());
 #endif
 
+	JsTask task;
 	std::string jsonReturnStr;
 
-	switch (JavascriptApi::getFunctionId(funcName)) {
-		case JavascriptApi::JS_QUERY_DOCKS: JS_QUERY_DOCKS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_EXECUTEJAVASCRIPT: JS_DOCK_EXECUTEJAVASCRIPT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_SETURL: JS_DOCK_SETURL(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOWNLOAD_ZIP: JS_DOWNLOAD_ZIP(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOWNLOAD_FILE: JS_DOWNLOAD_FILE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_READ_FILE: JS_READ_FILE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DELETE_FILES: JS_DELETE_FILES(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DROP_FOLDER: JS_DROP_FOLDER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_QUERY_DOWNLOADS_FOLDER: JS_QUERY_DOWNLOADS_FOLDER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_LOGS_REPORT_STRING: JS_GET_LOGS_REPORT_STRING(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_SOURCE_CREATE: JS_OBS_SOURCE_CREATE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_SOURCE_DESTROY: JS_OBS_SOURCE_DESTROY(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_SETAREA: JS_DOCK_SETAREA(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_RESIZE: JS_DOCK_RESIZE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_NEW_BROWSER_DOCK: JS_DOCK_NEW_BROWSER_DOCK(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_MAIN_WINDOW_GEOMETRY: JS_GET_MAIN_WINDOW_GEOMETRY(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_TOGGLE_USER_INPUT: JS_TOGGLE_USER_INPUT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_TOGGLE_DOCK_VISIBILITY: JS_TOGGLE_DOCK_VISIBILITY(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_SWAP: JS_DOCK_SWAP(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DESTROY_DOCK: JS_DESTROY_DOCK(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_RENAME: JS_DOCK_RENAME(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_DOCK_SETTITLE: JS_DOCK_SETTITLE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_STREAMSETTINGS: JS_SET_STREAMSETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_STREAMSETTINGS: JS_GET_STREAMSETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SL_VERSION_INFO: JS_SL_VERSION_INFO(jsonParams, jsonReturnStr); break;		
-		case JavascriptApi::JS_START_WEBSERVER: JS_START_WEBSERVER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_STOP_WEBSERVER: JS_STOP_WEBSERVER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_LAUNCH_OS_BROWSER_URL: JS_LAUNCH_OS_BROWSER_URL(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_AUTH_TOKEN: JS_GET_AUTH_TOKEN(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_CLEAR_AUTH_TOKEN: JS_CLEAR_AUTH_TOKEN(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_CURRENT_SCENE: JS_SET_CURRENT_SCENE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_CREATE_SCENE: JS_CREATE_SCENE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SCENE_ADD: JS_SCENE_ADD(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SOURCE_GET_PROPERTIES: JS_SOURCE_GET_PROPERTIES(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SOURCE_GET_SETTINGS: JS_SOURCE_GET_SETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SOURCE_SET_SETTINGS: JS_SOURCE_SET_SETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_INSTALL_FONT: JS_INSTALL_FONT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENE_COLLECTIONS: JS_GET_SCENE_COLLECTIONS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_CURRENT_SCENE_COLLECTION: JS_GET_CURRENT_SCENE_COLLECTION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_CURRENT_SCENE_COLLECTION: JS_SET_CURRENT_SCENE_COLLECTION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_ADD_SCENE_COLLECTION: JS_ADD_SCENE_COLLECTION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_POS: JS_SET_SCENEITEM_POS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_ROT: JS_SET_SCENEITEM_ROT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_CROP: JS_SET_SCENEITEM_CROP(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_SCALE_FILTER: JS_SET_SCENEITEM_SCALE_FILTER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_BLENDING_MODE: JS_SET_SCENEITEM_BLENDING_MODE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCENEITEM_BLENDING_METHOD: JS_SET_SCENEITEM_BLENDING_METHOD(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SET_SCALE: JS_SET_SCALE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_POS: JS_GET_SCENEITEM_POS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_ROT: JS_GET_SCENEITEM_ROT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_CROP: JS_GET_SCENEITEM_CROP(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_SCALE_FILTER: JS_GET_SCENEITEM_SCALE_FILTER(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_BLENDING_MODE: JS_GET_SCENEITEM_BLENDING_MODE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCENEITEM_BLENDING_METHOD: JS_GET_SCENEITEM_BLENDING_METHOD(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_SCALE: JS_GET_SCALE(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SCENE_GET_SOURCES: JS_SCENE_GET_SOURCES(jsonParams, jsonReturnStr); break;	
-		case JavascriptApi::JS_QUERY_ALL_SOURCES: JS_QUERY_ALL_SOURCES(jsonParams, jsonReturnStr); break;		
-		case JavascriptApi::JS_GET_SOURCE_DIMENSIONS: JS_GET_SOURCE_DIMENSIONS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_CANVAS_DIMENSIONS: JS_GET_CANVAS_DIMENSIONS(jsonParams,jsonReturnStr); break;
-		case JavascriptApi::JS_GET_CURRENT_SCENE: JS_GET_CURRENT_SCENE(jsonParams,jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_BRING_FRONT: JS_OBS_BRING_FRONT(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_TOGGLE_HIDE_SELF: JS_OBS_TOGGLE_HIDE_SELF(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_ADD_TRANSITION: JS_OBS_ADD_TRANSITION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_SET_CURRENT_TRANSITION: JS_OBS_SET_CURRENT_TRANSITION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_OBS_REMOVE_TRANSITION: JS_OBS_REMOVE_TRANSITION(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_TRANSITION_GET_SETTINGS: JS_TRANSITION_GET_SETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_TRANSITION_SET_SETTINGS: JS_TRANSITION_SET_SETTINGS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_ENUM_SCENES: JS_ENUM_SCENES(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_RESTART_OBS: JS_RESTART_OBS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_GET_IS_OBS_STREAMING: JS_GET_IS_OBS_STREAMING(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_SAVE_SL_BROWSER_DOCKS: JS_SAVE_SL_BROWSER_DOCKS(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_QT_SET_JS_ON_CLICK_STREAM: JS_QT_SET_JS_ON_CLICK_STREAM(jsonParams, jsonReturnStr); break;
-		case JavascriptApi::JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON: JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON(jsonParams, jsonReturnStr); break;		
-		default: jsonReturnStr = Json(Json::object{{"error", "Unknown Javascript Function"}}).dump(); break;
+	t_currentBrowserId = request.browserid();
+	t_currentFuncId = funcId;
+	t_currentNavigation = request.navigation();
+
+	if (!dispatch(apiId, args, task, jsonReturnStr))
+		jsonReturnStr = JsonWriter::object(JsonKeys::kError, "Unknown Javascript Function");
+
+	// Coroutine handlers finish after their Qt hop, the worker is free for the next call meanwhile
+	if (task.valid())
+	{
+		if (isSuperseded)
+			task.setStaleCheck(std::move(isSuperseded), JsonWriter::object("coalesced", true));
+
+		task.start([funcId, onComplete](const std::string &jsonReturn) { onComplete(funcId, jsonReturn); });
+		return;
 	}
 
 #ifndef GITHUB_REVISION
-	blog(LOG_INFO, "executeApiRequest (finish) %s: %s\n", funcName.c_str(), params.c_str());
+	blog(LOG_INFO, "executeApiRequest (finish) %s\n", funcName.c_str());
 #endif
 
-	// We're done, send callback
-	if (param1Value.int_value() > 0)
-		GrpcPlugin::instance().getClient()->send_executeCallback(param1Value.int_value(), jsonReturnStr);
+	// We're done, the result goes back in the reply to the original call
+	onComplete(funcId, jsonReturnStr);
+}
+
+bool PluginJsHandler::dispatch(const JavascriptApi::JSFuncs apiId, JsArgs &args, JsTask &out_task, std::string &out_jsonReturn)
+{
+	if (apiId <= JavascriptApi::JS_INVALID || apiId >= JavascriptApi::JS_FUNC_COUNT)
+		return false;
+
+	const auto invoke = typedHandlers()[apiId];
+
+	if (!invoke)
+		return false;
+
+	out_task = invoke(*this, args, out_jsonReturn);
+	return true;
+}
+
+const PluginJsHandler::TypedHandlers &PluginJsHandler::typedHandlers()
+{
+	using JsHandlerBinding::Bound;
+
+	static const TypedHandlers handlers = [] {
+		TypedHandlers table{};
+		table[JavascriptApi::JS_QUERY_DOCKS] = &Bound<&PluginJsHandler::JS_QUERY_DOCKS>::invoke;
+		table[JavascriptApi::JS_DOCK_SETAREA] = &Bound<&PluginJsHandler::JS_DOCK_SETAREA>::invoke;
+		table[JavascriptApi::JS_DOCK_RESIZE] = &Bound<&PluginJsHandler::JS_DOCK_RESIZE>::invoke;
+		table[JavascriptApi::JS_GET_MAIN_WINDOW_GEOMETRY] = &Bound<&PluginJsHandler::JS_GET_MAIN_WINDOW_GEOMETRY>::invoke;
+		table[JavascriptApi::JS_TOGGLE_DOCK_VISIBILITY] = &Bound<&PluginJsHandler::JS_TOGGLE_DOCK_VISIBILITY>::invoke;
+		table[JavascriptApi::JS_DOCK_SWAP] = &Bound<&PluginJsHandler::JS_DOCK_SWAP>::invoke;
+		table[JavascriptApi::JS_DESTROY_DOCK] = &Bound<&PluginJsHandler::JS_DESTROY_DOCK>::invoke;
+		table[JavascriptApi::JS_DOCK_SETTITLE] = &Bound<&PluginJsHandler::JS_DOCK_SETTITLE>::invoke;
+		table[JavascriptApi::JS_SET_STREAMSETTINGS] = &Bound<&PluginJsHandler::JS_SET_STREAMSETTINGS>::invoke;
+		table[JavascriptApi::JS_GET_STREAMSETTINGS] = &Bound<&PluginJsHandler::JS_GET_STREAMSETTINGS>::invoke;
+		table[JavascriptApi::JS_SET_CURRENT_SCENE] = &Bound<&PluginJsHandler::JS_SET_CURRENT_SCENE>::invoke;
+		table[JavascriptApi::JS_CREATE_SCENE] = &Bound<&PluginJsHandler::JS_CREATE_SCENE>::invoke;
+		table[JavascriptApi::JS_SCENE_ADD] = &Bound<&PluginJsHandler::JS_SCENE_ADD>::invoke;
+		table[JavascriptApi::JS_SOURCE_GET_PROPERTIES] = &Bound<&PluginJsHandler::JS_SOURCE_GET_PROPERTIES>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_POS] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_POS>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_ROT] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_ROT>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_CROP] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_CROP>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_SCALE_FILTER] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_SCALE_FILTER>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_BLENDING_MODE] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_BLENDING_MODE>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_BLENDING_METHOD] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_BLENDING_METHOD>::invoke;
+		table[JavascriptApi::JS_SET_SCENEITEM_TRANSFORMS] = &Bound<&PluginJsHandler::JS_SET_SCENEITEM_TRANSFORMS>::invoke;
+		table[JavascriptApi::JS_SCENE_GRAPH_SNAPSHOT] = &Bound<&PluginJsHandler::JS_SCENE_GRAPH_SNAPSHOT>::invoke;
+		table[JavascriptApi::JS_SCENE_GRAPH_DIFF] = &Bound<&PluginJsHandler::JS_SCENE_GRAPH_DIFF>::invoke;
+		table[JavascriptApi::JS_OBS_SUBSCRIBE_EVENTS] = &Bound<&PluginJsHandler::JS_OBS_SUBSCRIBE_EVENTS>::invoke;
+		table[JavascriptApi::JS_SET_SCALE] = &Bound<&PluginJsHandler::JS_SET_SCALE>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_POS] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_POS>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_ROT] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_ROT>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_CROP] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_CROP>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_SCALE_FILTER] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_SCALE_FILTER>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_BLENDING_MODE] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_BLENDING_MODE>::invoke;
+		table[JavascriptApi::JS_GET_SCENEITEM_BLENDING_METHOD] = &Bound<&PluginJsHandler::JS_GET_SCENEITEM_BLENDING_METHOD>::invoke;
+		table[JavascriptApi::JS_GET_SCALE] = &Bound<&PluginJsHandler::JS_GET_SCALE>::invoke;
+		table[JavascriptApi::JS_SCENE_GET_SOURCES] = &Bound<&PluginJsHandler::JS_SCENE_GET_SOURCES>::invoke;
+		table[JavascriptApi::JS_QUERY_ALL_SOURCES] = &Bound<&PluginJsHandler::JS_QUERY_ALL_SOURCES>::invoke;
+		table[JavascriptApi::JS_GET_SOURCE_DIMENSIONS] = &Bound<&PluginJsHandler::JS_GET_SOURCE_DIMENSIONS>::invoke;
+		table[JavascriptApi::JS_GET_CANVAS_DIMENSIONS] = &Bound<&PluginJsHandler::JS_GET_CANVAS_DIMENSIONS>::invoke;
+		table[JavascriptApi::JS_GET_CURRENT_SCENE] = &Bound<&PluginJsHandler::JS_GET_CURRENT_SCENE>::invoke;
+		table[JavascriptApi::JS_OBS_TOGGLE_HIDE_SELF] = &Bound<&PluginJsHandler::JS_OBS_TOGGLE_HIDE_SELF>::invoke;
+		table[JavascriptApi::JS_OBS_REMOVE_TRANSITION] = &Bound<&PluginJsHandler::JS_OBS_REMOVE_TRANSITION>::invoke;
+		table[JavascriptApi::JS_TRANSITION_GET_SETTINGS] = &Bound<&PluginJsHandler::JS_TRANSITION_GET_SETTINGS>::invoke;
+		table[JavascriptApi::JS_TRANSITION_SET_SETTINGS] = &Bound<&PluginJsHandler::JS_TRANSITION_SET_SETTINGS>::invoke;
+		table[JavascriptApi::JS_ENUM_SCENES] = &Bound<&PluginJsHandler::JS_ENUM_SCENES>::invoke;
+		table[JavascriptApi::JS_TOGGLE_USER_INPUT] = &Bound<&PluginJsHandler::JS_TOGGLE_USER_INPUT>::invoke;
+		table[JavascriptApi::JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON] = &Bound<&PluginJsHandler::JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON>::invoke;
+		table[JavascriptApi::JS_OBS_SET_CURRENT_TRANSITION] = &Bound<&PluginJsHandler::JS_OBS_SET_CURRENT_TRANSITION>::invoke;
+		table[JavascriptApi::JS_OBS_ADD_TRANSITION] = &Bound<&PluginJsHandler::JS_OBS_ADD_TRANSITION>::invoke;
+		table[JavascriptApi::JS_SAVE_SL_BROWSER_DOCKS] = &Bound<&PluginJsHandler::JS_SAVE_SL_BROWSER_DOCKS>::invoke;
+		table[JavascriptApi::JS_BATCH] = &Bound<&PluginJsHandler::JS_BATCH>::invoke;
+		table[JavascriptApi::JS_DOCK_EXECUTEJAVASCRIPT] = &Bound<&PluginJsHandler::JS_DOCK_EXECUTEJAVASCRIPT>::invoke;
+		table[JavascriptApi::JS_DOCK_SETURL] = &Bound<&PluginJsHandler::JS_DOCK_SETURL>::invoke;
+		table[JavascriptApi::JS_OBS_SOURCE_CREATE] = &Bound<&PluginJsHandler::JS_OBS_SOURCE_CREATE>::invoke;
+		table[JavascriptApi::JS_OBS_SOURCE_DESTROY] = &Bound<&PluginJsHandler::JS_OBS_SOURCE_DESTROY>::invoke;
+		table[JavascriptApi::JS_DOCK_NEW_BROWSER_DOCK] = &Bound<&PluginJsHandler::JS_DOCK_NEW_BROWSER_DOCK>::invoke;
+		table[JavascriptApi::JS_DOWNLOAD_ZIP] = &Bound<&PluginJsHandler::JS_DOWNLOAD_ZIP>::invoke;
+		table[JavascriptApi::JS_DOWNLOAD_FILE] = &Bound<&PluginJsHandler::JS_DOWNLOAD_FILE>::invoke;
+		table[JavascriptApi::JS_READ_FILE] = &Bound<&PluginJsHandler::JS_READ_FILE>::invoke;
+		table[JavascriptApi::JS_DELETE_FILES] = &Bound<&PluginJsHandler::JS_DELETE_FILES>::invoke;
+		table[JavascriptApi::JS_DROP_FOLDER] = &Bound<&PluginJsHandler::JS_DROP_FOLDER>::invoke;
+		table[JavascriptApi::JS_QUERY_DOWNLOADS_FOLDER] = &Bound<&PluginJsHandler::JS_QUERY_DOWNLOADS_FOLDER>::invoke;
+		table[JavascriptApi::JS_GET_LOGS_REPORT_STRING] = &Bound<&PluginJsHandler::JS_GET_LOGS_REPORT_STRING>::invoke;
+		table[JavascriptApi::JS_DOCK_RENAME] = &Bound<&PluginJsHandler::JS_DOCK_RENAME>::invoke;
+		table[JavascriptApi::JS_SL_VERSION_INFO] = &Bound<&PluginJsHandler::JS_SL_VERSION_INFO>::invoke;
+		table[JavascriptApi::JS_START_WEBSERVER] = &Bound<&PluginJsHandler::JS_START_WEBSERVER>::invoke;
+		table[JavascriptApi::JS_STOP_WEBSERVER] = &Bound<&PluginJsHandler::JS_STOP_WEBSERVER>::invoke;
+		table[JavascriptApi::JS_LAUNCH_OS_BROWSER_URL] = &Bound<&PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL>::invoke;
+		table[JavascriptApi::JS_GET_AUTH_TOKEN] = &Bound<&PluginJsHandler::JS_GET_AUTH_TOKEN>::invoke;
+		table[JavascriptApi::JS_CLEAR_AUTH_TOKEN] = &Bound<&PluginJsHandler::JS_CLEAR_AUTH_TOKEN>::invoke;
+		table[JavascriptApi::JS_SOURCE_GET_SETTINGS] = &Bound<&PluginJsHandler::JS_SOURCE_GET_SETTINGS>::invoke;
+		table[JavascriptApi::JS_SOURCE_SET_SETTINGS] = &Bound<&PluginJsHandler::JS_SOURCE_SET_SETTINGS>::invoke;
+		table[JavascriptApi::JS_INSTALL_FONT] = &Bound<&PluginJsHandler::JS_INSTALL_FONT>::invoke;
+		table[JavascriptApi::JS_GET_SCENE_COLLECTIONS] = &Bound<&PluginJsHandler::JS_GET_SCENE_COLLECTIONS>::invoke;
+		table[JavascriptApi::JS_GET_CURRENT_SCENE_COLLECTION] = &Bound<&PluginJsHandler::JS_GET_CURRENT_SCENE_COLLECTION>::invoke;
+		table[JavascriptApi::JS_SET_CURRENT_SCENE_COLLECTION] = &Bound<&PluginJsHandler::JS_SET_CURRENT_SCENE_COLLECTION>::invoke;
+		table[JavascriptApi::JS_ADD_SCENE_COLLECTION] = &Bound<&PluginJsHandler::JS_ADD_SCENE_COLLECTION>::invoke;
+		table[JavascriptApi::JS_OBS_BRING_FRONT] = &Bound<&PluginJsHandler::JS_OBS_BRING_FRONT>::invoke;
+		table[JavascriptApi::JS_RESTART_OBS] = &Bound<&PluginJsHandler::JS_RESTART_OBS>::invoke;
+		table[JavascriptApi::JS_GET_IS_OBS_STREAMING] = &Bound<&PluginJsHandler::JS_GET_IS_OBS_STREAMING>::invoke;
+		table[JavascriptApi::JS_QT_SET_JS_ON_CLICK_STREAM] = &Bound<&PluginJsHandler::JS_QT_SET_JS_ON_CLICK_STREAM>::invoke;
+		return table;
+	}();
+
+	return handlers;
+}
+
+JsTask PluginJsHandler::JS_BATCH(std::string calls)
+{
+	std::string out_jsonReturn;
+
+	// Arena parsed, a long batch used to be a shared_ptr per value and a std::map per call before anything ran
+	JsonDocument document;
+	std::string err;
+
+	if (!document.parse(calls, err) || !document.root().is_array())
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		co_return out_jsonReturn;
+	}
+
+	if (document.root().size() > kMaxBatchCalls)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Too many calls in one batch");
+		co_return out_jsonReturn;
+	}
+
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+
+	// One hop for the whole list, the handlers' own Qt hops run inline from here
+	co_await onQtThread(mainWindow, [this, &document, &out_jsonReturn]() {
+		JsonDocument resultCheck;
+		out_jsonReturn = "[";
+
+		for (const JsonNode &call : document.root())
+		{
+			if (out_jsonReturn.size() > 1)
+				out_jsonReturn += ',';
+
+			runBatchedCall(call, resultCheck, out_jsonReturn);
+		}
+
+		out_jsonReturn += ']';
+	});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_START_WEBSERVER(const json11::Json &params, std::string &out_jsonReturn)
+// Qt thread, appends the call's result to 'out_results'
+void PluginJsHandler::runBatchedCall(const JsonNode &call, JsonDocument &resultCheck, std::string &out_results)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
+	const std::string funcName(call[0].string_value());
+
+	if (!JavascriptApi::isPluginFunctionName(funcName))
+	{
+		out_results += JsonWriter::object(JsonKeys::kError, "Unknown Javascript Function");
+		return;
+	}
 
-	WebServer::instance().setExpectedReferer(param3Value.string_value());
-	WebServer::instance().setRedirectUrl(param4Value.string_value());
+	const JavascriptApi::JSFuncs apiId = JavascriptApi::getFunctionId(funcName);
 
-	if (WebServer::instance().isAlreadyStarted())
+	// A subscription would push to the batch's callback, io work would stall the ui
+	if (apiId == JavascriptApi::JS_BATCH || apiId == JavascriptApi::JS_OBS_SUBSCRIBE_EVENTS || JavascriptApi::getLane(apiId) == JavascriptApi::LANE_IO)
 	{
-		out_jsonReturn = Json(Json::object{{"port", WebServer::instance().getPort()}}).dump();
+		out_results += JsonWriter::object(JsonKeys::kError, "Not allowed in a batch");
 		return;
 	}
 
-	if (!WebServer::instance().start(param2Value.int_value()))
+	// Same arguments a single call gets, param1 would have been its callback
+	JsArgs args;
+
+	for (size_t i = 1; i < call.size(); ++i)
+		args.add(call[i]);
+
+	const auto invoke = typedHandlers()[apiId];
+
+	if (!invoke)
 	{
-		out_jsonReturn = Json(Json::object{{"error", WebServer::instance().getErr()}}).dump();
+		out_results += JsonWriter::object(JsonKeys::kError, "Unknown Javascript Function");
 		return;
 	}
 
-	out_jsonReturn = Json(Json::object{{"port", WebServer::instance().getPort()}}).dump();
+	std::string jsonReturn;
+	JsTask task = invoke(*this, args, jsonReturn);
+
+	// One that didn't start either ran already or has its error in jsonReturn
+	if (task.valid())
+	{
+		// Shared in case a handler ever hops somewhere that isn't inline, it then finishes on its own after the batch
+		auto result = std::make_shared<std::string>();
+		auto done = std::make_shared<bool>(false);
+		task.start([result, done](const std::string &taskReturn) {
+			*result = taskReturn;
+			*done = true;
+		});
+
+		if (!*done)
+		{
+			out_results += JsonWriter::object(JsonKeys::kError, "Did not finish inside the batch");
+			return;
+		}
+
+		jsonReturn = std::move(*result);
+	}
+
+	std::string err;
+
+	// Handlers already return json, it goes in as is once it's known to be valid instead of a parse and a dump()
+	if (jsonReturn.empty())
+		out_results += "null";
+	else if (resultCheck.parse(jsonReturn, err))
+		out_results += jsonReturn;
+	else
+		JsonWriter(out_results).value(jsonReturn);
+}
+
+std::string PluginJsHandler::JS_START_WEBSERVER(int port, std::string expectedReferer, std::string redirectUrl)
+{
+	std::string out_jsonReturn;
+
+	WebServer::instance().setExpectedReferer(expectedReferer);
+	WebServer::instance().setRedirectUrl(redirectUrl);
+
+	if (WebServer::instance().isAlreadyStarted())
+	{
+		out_jsonReturn = JsonWriter::object("port", WebServer::instance().getPort());
+		return out_jsonReturn;
+	}
+
+	if (!WebServer::instance().start(port))
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, WebServer::instance().getErr());
+		return out_jsonReturn;
+	}
+
+	out_jsonReturn = JsonWriter::object("port", WebServer::instance().getPort());
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_STOP_WEBSERVER(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_STOP_WEBSERVER()
 {
 	WebServer::instance().stop();
+	return std::string();
 }
 
-void PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL(std::string url)
 {
+	std::string out_jsonReturn;
+
 	auto getRegistryValue = [](const HKEY rootKey, const std::string &subKey, const std::string &valueName)
 	{
 		HKEY hKey;
@@ -331,8 +752,6 @@ void PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL(const json11::Json &params, std::
 		return getRegistryValue(HKEY_LOCAL_MACHINE, browserPathKey, "");
 	};
 	
-	const auto &param2Value = params["param2"];
-	std::string url = param2Value.string_value();
 	std::string browserCommand = getDefaultBrowserPath();
 
 	if (browserCommand.empty())
@@ -345,7 +764,7 @@ void PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL(const json11::Json &params, std::
 		sei.lpFile = url.c_str();
 		sei.nShow = SW_SHOWNORMAL;
 		ShellExecuteExA(&sei);
-		return;
+		return out_jsonReturn;
 	}
 
 	size_t placeholderPos = browserCommand.find("%1");
@@ -424,34 +843,50 @@ void PluginJsHandler::JS_LAUNCH_OS_BROWSER_URL(const json11::Json &params, std::
 			return callback(hwnd, lParam);
 		},
 		reinterpret_cast<LPARAM>(&enumWindowsCallback));
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_AUTH_TOKEN(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_GET_AUTH_TOKEN()
 {
-	out_jsonReturn = Json(Json::object{{"token", WebServer::instance().getToken()}}).dump();
+	return JsonWriter::object("token", WebServer::instance().getToken());
 }
 
-void PluginJsHandler::JS_CLEAR_AUTH_TOKEN(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_CLEAR_AUTH_TOKEN()
 {
 	WebServer::instance().clearToken();
-	out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+	return JsonWriter::object(JsonKeys::kStatus, "success");
 }
 
-void PluginJsHandler::JS_SL_VERSION_INFO(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_SL_VERSION_INFO()
 {
+	std::string out_jsonReturn;
+	JsonWriter writer(out_jsonReturn);
+
 #ifdef GITHUB_REVISION
-	out_jsonReturn = Json(Json::object{{"branch", SL_OBS_VERSION}, {"git_sha", GITHUB_REVISION}, {"rev", SL_REVISION}}).dump();
+	writer.beginObject().member("branch", SL_OBS_VERSION).member("git_sha", GITHUB_REVISION).member("rev", SL_REVISION).endObject();
 #else
-	out_jsonReturn = Json(Json::object{{"branch", "debug"}, {"git_sha", "debug"}, {"rev", "debug"}}).dump();
+	writer.beginObject().member("branch", "debug").member("git_sha", "debug").member("rev", "debug").endObject();
 #endif
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_STREAMSETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_STREAMSETTINGS()
 {
+	std::string out_jsonReturn;
+
+	ObsReadCache &cache = ObsReadCache::instance();
+	std::string cached;
+	uint64_t generation = 0;
+	const bool hit = cache.lookup(ObsReadCache::STREAM_SETTINGS, cached, generation);
+
+	if (hit && !cache.crossChecking())
+		co_return cached;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, &out_jsonReturn]() {
 			obs_service_t *service_t = obs_frontend_get_streaming_service();
 
@@ -467,39 +902,40 @@ void PluginJsHandler::JS_GET_STREAMSETTINGS(const json11::Json &params, std::str
 				std::string password = obs_data_get_string(settings, "password");
 				std::string key = obs_data_get_string(settings, "key");
 
-				out_jsonReturn = Json(Json::object{{"service", service}, {"protocol", protocol}, {"server", server}, {"use_auth", use_auth}, {"username", username}, {"password", password}, {"key", key}}).dump();
+				JsonWriter(out_jsonReturn)
+					.beginObject()
+					.member("service", service)
+					.member("protocol", protocol)
+					.member("server", server)
+					.member("use_auth", use_auth)
+					.member("username", username)
+					.member("password", password)
+					.member("key", key)
+					.endObject();
 			}
 			else
 			{
-				out_jsonReturn = Json(Json::object({{"error", "No service exists"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "No service exists");
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	if (hit)
+		cache.crossCheck(ObsReadCache::STREAM_SETTINGS, generation, cached, out_jsonReturn);
+	else
+		cache.store(ObsReadCache::STREAM_SETTINGS, generation, out_jsonReturn);
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_STREAMSETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_STREAMSETTINGS(std::string service, std::string protocol, std::string server, bool use_auth, std::string username, std::string password, std::string key)
 {
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	std::string out_jsonReturn;
 
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-	const auto &param5Value = params["param5"];
-	const auto &param6Value = params["param6"];
-	const auto &param7Value = params["param7"];
-	const auto &param8Value = params["param8"];
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// "rtmp_custom" : "rtmp_common"
-	std::string service = param2Value.string_value();
-	std::string protocol = param3Value.string_value();
-	std::string server = param4Value.string_value();
-	bool use_auth = param5Value.bool_value();
-	std::string username = param6Value.string_value();
-	std::string password = param7Value.string_value();
-	std::string key = param8Value.string_value();
-
-	QMetaObject::invokeMethod(
-		mainWindow,
+
+	co_await onQtThread(mainWindow,
 		[mainWindow, &service, &protocol, &server, use_auth, &username, &password, &key, &out_jsonReturn]() {
 
 			obs_service_t *oldService = obs_frontend_get_streaming_service();
@@ -522,18 +958,23 @@ void PluginJsHandler::JS_SET_STREAMSETTINGS(const json11::Json &params, std::str
 
 			obs_frontend_set_streaming_service(newService);
 			obs_frontend_save_streaming_service();
-		},
-		Qt::BlockingQueuedConnection);
+
+			ObsReadCache::instance().invalidate(ObsReadCache::STREAM_SETTINGS);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_QUERY_DOCKS(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_QUERY_DOCKS()
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, &out_jsonReturn]() {
-			std::vector<Json> dockInfo;
+			JsonWriter writer(out_jsonReturn);
+			writer.beginArray();
 
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 			foreach(QDockWidget * dock, docks)
@@ -566,33 +1007,36 @@ void PluginJsHandler::JS_QUERY_DOCKS(const Json &params, std::string &out_jsonRe
 					}
 				}
 
-				// Create a Json object for this dock widget and add it to the panelInfo vector
-				dockInfo.push_back(Json::object{{"name", name}, {"x", x}, {"y", y}, {"width", width}, {"height", height}, {"floating", floating},
-					{"isSlabs", isSlabs}, {"url", url}, {"visible", visible}, {"title", dockTitle}});
+				writer.beginObject()
+					.member("name", name)
+					.member("x", x)
+					.member("y", y)
+					.member("width", width)
+					.member("height", height)
+					.member("floating", floating)
+					.member("isSlabs", isSlabs)
+					.member("url", url)
+					.member("visible", visible)
+					.member("title", dockTitle)
+					.endObject();
 			}
 
-			// Convert the panelInfo vector to a Json object and dump string
-			Json ret = dockInfo;
-			out_jsonReturn = ret.dump();
-		},
-		Qt::BlockingQueuedConnection);
+			writer.endArray();
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_SWAP(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_SWAP(std::string objectName1, std::string objectName2)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string objectName1 = param2Value.string_value();
-	std::string objectName2 = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	// Assume failure until we find the docks and swap them
-	out_jsonReturn = Json(Json::object({{"error", "Did not find docks with objectNames: " + objectName1 + " and " + objectName2}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find docks with objectNames: " + objectName1 + " and " + objectName2);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, objectName1, objectName2, &out_jsonReturn]() {
 			QDockWidget *dock1 = nullptr;
 			QDockWidget *dock2 = nullptr;
@@ -618,29 +1062,23 @@ void PluginJsHandler::JS_DOCK_SWAP(const Json &params, std::string &out_jsonRetu
 				dock1->setGeometry(geo2);
 				dock2->setGeometry(geo1);
 
-				out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_RESIZE(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_RESIZE(std::string objectName, int width, int height)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-
-	std::string objectName = param2Value.string_value();
-	int width = param3Value.int_value();
-	int height = param3Value.int_value();
+	std::string out_jsonReturn;
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, objectName, width, height, &out_jsonReturn]() {
 			// Find the panel by name (assuming the name is stored as a property)
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
@@ -649,29 +1087,25 @@ void PluginJsHandler::JS_DOCK_RESIZE(const Json &params, std::string &out_jsonRe
 				if (dock->objectName().toStdString() == objectName)
 				{
 					dock->resize(width, height);
-					out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_SETAREA(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_SETAREA(std::string objectName, int areaMask)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string objectName = param2Value.string_value();
-	int areaMask = param3Value.int_value();
+	std::string out_jsonReturn;
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, objectName, areaMask, &out_jsonReturn]() {
 			// Find the panel by name (assuming the name is stored as a property)
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
@@ -685,37 +1119,33 @@ void PluginJsHandler::JS_DOCK_SETAREA(const Json &params, std::string &out_jsonR
 					// Map the input area mask to the corresponding Qt::DockWidgetArea
 					Qt::DockWidgetArea dockArea = static_cast<Qt::DockWidgetArea>(areaMask & Qt::DockWidgetArea_Mask);
 					mainWindow->addDockWidget(dockArea, dock);
-					out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_EXECUTEJAVASCRIPT(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_EXECUTEJAVASCRIPT(std::string objectName, std::string javascriptCode)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
+	std::string out_jsonReturn;
 
-	std::string objectName = param2Value.string_value();
-	std::string javascriptcode = param3Value.string_value();
-
-	if (javascriptcode.empty())
+	if (javascriptCode.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid params"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		co_return out_jsonReturn;
 	}
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, javascriptcode, objectName, &out_jsonReturn]() {
+	co_await onQtThread(mainWindow,
+		[mainWindow, javascriptCode, objectName, &out_jsonReturn]() {
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 			foreach(QDockWidget * dock, docks)
 			{
@@ -727,47 +1157,43 @@ void PluginJsHandler::JS_DOCK_EXECUTEJAVASCRIPT(const Json &params, std::string
 					{
 						if (auto mainframe = browser->GetMainFrame())
 						{
-							mainframe->ExecuteJavaScript(javascriptcode.c_str(), mainframe->GetURL(), 0);
-							out_jsonReturn = Json(Json::object{{"status", "Found dock and ran ExecuteJavaScript on " + mainframe->GetURL().ToString()}}).dump();
+							mainframe->ExecuteJavaScript(javascriptCode.c_str(), mainframe->GetURL(), 0);
+							out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "Found dock and ran ExecuteJavaScript on " + mainframe->GetURL().ToString());
 						}
 					}
 
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_TOGGLE_USER_INPUT(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_TOGGLE_USER_INPUT(bool enable)
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-	bool enable = params["param2"].bool_value();
 
-	QMetaObject::invokeMethod(
-		mainWindow, [mainWindow, enable]() { ::EnableWindow(reinterpret_cast<HWND>(mainWindow->winId()), enable); }, Qt::BlockingQueuedConnection);
+	co_await onQtThread(mainWindow, [mainWindow, enable]() { ::EnableWindow(reinterpret_cast<HWND>(mainWindow->winId()), enable); });
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_NEW_BROWSER_DOCK(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_NEW_BROWSER_DOCK(std::string title, std::string url, std::string objectName)
 {
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
+	std::string out_jsonReturn;
 
-	std::string title = param2Value.string_value();
-	std::string url = param3Value.string_value();
-	std::string objectName = param4Value.string_value();
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	if (objectName.empty() || title.empty() || url.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid params"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		co_return out_jsonReturn;
 	}
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, objectName, title, url, &out_jsonReturn]() {
 			// Check duplication
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
@@ -775,7 +1201,7 @@ void PluginJsHandler::JS_DOCK_NEW_BROWSER_DOCK(const json11::Json &params, std::
 			{
 				if (dock->objectName().toStdString() == objectName)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Already exists"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Already exists");
 					return;
 				}
 			}
@@ -802,79 +1228,75 @@ void PluginJsHandler::JS_DOCK_NEW_BROWSER_DOCK(const json11::Json &params, std::
 
 			// Can't use yet
 			//obs_frontend_add_dock_by_id(objectName.c_str(), title.c_str(), nullptr);
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON()
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-	out_jsonReturn = Json(Json::object{{"status", "failure"}}).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "failure");
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, &out_jsonReturn]() {
 			if (QApplication::activeModalWidget())
 			{
-				out_jsonReturn = Json(Json::object{{"error", "activeModalWidget"}}).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "activeModalWidget");
 			}
 			else
 			{
 				QtGuiModifications::instance().outsideInvokeClickStreamButton();
-				out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
 
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_QT_SET_JS_ON_CLICK_STREAM(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_QT_SET_JS_ON_CLICK_STREAM(std::string javascriptCode)
 {
-	const auto &param2Value = params["param2"];
-	std::string jsstr = param2Value.string_value();
-
-	QtGuiModifications::instance().setJavascriptToCallOnStreamClick(jsstr);
-	out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+	QtGuiModifications::instance().setJavascriptToCallOnStreamClick(javascriptCode);
+	return JsonWriter::object(JsonKeys::kStatus, "success");
 }
 
-void PluginJsHandler::JS_GET_MAIN_WINDOW_GEOMETRY(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_MAIN_WINDOW_GEOMETRY()
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, &out_jsonReturn]() {
 			int x = mainWindow->geometry().x();
 			int y = mainWindow->geometry().y();
 			int width = mainWindow->width();
 			int height = mainWindow->height();
-			out_jsonReturn = Json(Json::object{{{"x", x}, {"y", y}, {"width", width}, {"height", height}}}).dump();
-		},
-		Qt::BlockingQueuedConnection);
+			JsonWriter(out_jsonReturn).beginObject().member(JsonKeys::kX, x).member(JsonKeys::kY, y).member(JsonKeys::kWidth, width).member(JsonKeys::kHeight, height).endObject();
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_SETURL(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_SETURL(std::string objectName, std::string url)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string objectName = param2Value.string_value();
-	std::string url = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (url.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid params"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		co_return out_jsonReturn;
 	}
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, url, objectName, &out_jsonReturn]() {
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 			foreach(QDockWidget * dock, docks)
@@ -883,30 +1305,26 @@ void PluginJsHandler::JS_DOCK_SETURL(const Json &params, std::string &out_jsonRe
 				{
 					QCefWidgetInternal *widget = (QCefWidgetInternal *)dock->widget();
 					widget->setURL(url.c_str());
-					out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_TOGGLE_DOCK_VISIBILITY(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_TOGGLE_DOCK_VISIBILITY(std::string objectName, bool visible)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string objectName = param2Value.string_value();
-	bool visible = param3Value.bool_value();
+	std::string out_jsonReturn;
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, visible, objectName, &out_jsonReturn]() {
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 			foreach(QDockWidget * dock, docks)
@@ -914,30 +1332,26 @@ void PluginJsHandler::JS_TOGGLE_DOCK_VISIBILITY(const Json &params, std::string
 				if (dock->objectName().toStdString() == objectName)
 				{
 					dock->setVisible(visible);
-					out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_SETTITLE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DOCK_SETTITLE(std::string objectName, std::string newTitle)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string objectName = param2Value.string_value();
-	std::string newTitle = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	// An error for now, if we succeed this is overwritten
-	out_jsonReturn = Json(Json::object({{"error", "Did not find dock with objectName: " + objectName}})).dump();
+	out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find dock with objectName: " + objectName);
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, newTitle, objectName, &out_jsonReturn]() {
 			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 			foreach(QDockWidget * dock, docks)
@@ -947,112 +1361,109 @@ void PluginJsHandler::JS_DOCK_SETTITLE(const json11::Json &params, std::string &
 					QAction *action = reinterpret_cast<QAction *>(dock->property("actionptr").toULongLong());
 					action->setText(newTitle.c_str());
 					dock->setWindowTitle(newTitle.c_str());
-					out_jsonReturn = Json(Json::object({{"status", "success"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 					break;
 				}
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOCK_RENAME(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_DOCK_RENAME(std::string objectName, std::string newName)
 {
-	out_jsonReturn = Json(Json::object({{"error", "deprecated"}})).dump();
+	return JsonWriter::object(JsonKeys::kError, "deprecated");
 }
 
-void PluginJsHandler::JS_DESTROY_DOCK(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_DESTROY_DOCK(std::string objectName)
 {
-	const auto &param2Value = params["param2"];
-	std::string objectName = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, objectName, &out_jsonReturn]() {
 			//obs_frontend_remove_dock(objectName.c_str());
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SOURCE_GET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+// obs_data json for the settings getters, 'raw' hands it over as the result itself instead of a json string holding it
+static std::string settingsReply(const char *json, const bool raw)
 {
-	const auto &param2Value = params["param2"];
-	std::string sourceName = param2Value.string_value();
+	std::string result;
 
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	if (!raw)
+		JsonWriter(result).value(json);
+	else
+		JsonWriter(result).raw(json ? json : "");
 
-	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, sourceName, &out_jsonReturn]() {
-			OBSSourceAutoRelease existingSource = obs_get_source_by_name(sourceName.c_str());
-			if (existingSource == nullptr)
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + sourceName}})).dump();
-				return;
-			}
+	return result;
+}
 
-			obs_data_t *settingsSource = obs_source_get_settings(existingSource);
-			if (settingsSource == nullptr)
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Error getting settings from " + sourceName}})).dump();
-				return;
-			}
+std::string PluginJsHandler::JS_SOURCE_GET_SETTINGS(std::string sourceName, bool raw)
+{
+	std::string out_jsonReturn;
 
-			out_jsonReturn = Json(obs_data_get_json(settingsSource)).dump();
-			obs_data_release(settingsSource);
-		},
-		Qt::BlockingQueuedConnection);
+	// Obs lane, libobs source lookups and settings are thread safe so there's no hop to the Qt thread
+	OBSSourceAutoRelease existingSource = obs_get_source_by_name(sourceName.c_str());
+	if (existingSource == nullptr)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + sourceName);
+		return out_jsonReturn;
+	}
+
+	obs_data_t *settingsSource = obs_source_get_settings(existingSource);
+	if (settingsSource == nullptr)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Error getting settings from " + sourceName);
+		return out_jsonReturn;
+	}
+
+	out_jsonReturn = settingsReply(obs_data_get_json(settingsSource), raw);
+	obs_data_release(settingsSource);
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SOURCE_SET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_SOURCE_SET_SETTINGS(std::string sourceName, std::string settingsJson)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	std::string sourceName = param2Value.string_value();
-	std::string settingsJson = param3Value.string_value();
+	std::string out_jsonReturn;
 
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	// Obs lane, obs_source_update is thread safe so there's no hop to the Qt thread
+	OBSSourceAutoRelease existingSource = obs_get_source_by_name(sourceName.c_str());
+	if (existingSource == nullptr)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + sourceName);
+		return out_jsonReturn;
+	}
 
-	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, sourceName, settingsJson, &out_jsonReturn]() {
-			OBSSourceAutoRelease existingSource = obs_get_source_by_name(sourceName.c_str());
-			if (existingSource == nullptr)
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + sourceName}})).dump();
-				return;
-			}
+	obs_data_t *newSettings = obs_data_create_from_json(settingsJson.c_str());
+	if (newSettings == nullptr)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Error parsing settings JSON");
+		return out_jsonReturn;
+	}
 
-			obs_data_t *newSettings = obs_data_create_from_json(settingsJson.c_str());
-			if (newSettings == nullptr)
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Error parsing settings JSON"}})).dump();
-				return;
-			}
+	obs_source_update(existingSource, newSettings);
+	obs_data_release(newSettings);
 
-			obs_source_update(existingSource, newSettings);
-			obs_data_release(newSettings);
+	out_jsonReturn = JsonWriter::object(JsonKeys::kSuccess, true);
 
-			out_jsonReturn = Json(Json::object({{"success", true}})).dump();
-		},
-		Qt::BlockingQueuedConnection);
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_TRANSITION_GET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_TRANSITION_GET_SETTINGS(std::string sourceName, bool raw)
 {
-	const auto &param2Value = params["param2"];
-	std::string sourceName = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, sourceName, &out_jsonReturn]() {
+	co_await onQtThread(mainWindow,
+		[mainWindow, sourceName, raw, &out_jsonReturn]() {
 			obs_frontend_source_list transitions = {};
 			obs_frontend_get_transitions(&transitions);
 
@@ -1071,35 +1482,32 @@ void PluginJsHandler::JS_TRANSITION_GET_SETTINGS(const json11::Json &params, std
 
 			if (!transition)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find transition named " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find transition named " + sourceName);
 				return;
 			}
 
 			obs_data_t *settingsSource = obs_source_get_settings(transition);
 			if (settingsSource == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Error getting settings from " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Error getting settings from " + sourceName);
 				return;
 			}
 
-			out_jsonReturn = Json(obs_data_get_json(settingsSource)).dump();
+			out_jsonReturn = settingsReply(obs_data_get_json(settingsSource), raw);
 			obs_data_release(settingsSource);
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_TRANSITION_SET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_TRANSITION_SET_SETTINGS(std::string sourceName, std::string settingsJson)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	std::string sourceName = param2Value.string_value();
-	std::string settingsJson = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, sourceName, settingsJson, &out_jsonReturn]() {
 			obs_frontend_source_list transitions = {};
 			obs_frontend_get_transitions(&transitions);
@@ -1119,35 +1527,34 @@ void PluginJsHandler::JS_TRANSITION_SET_SETTINGS(const json11::Json &params, std
 
 			if (!transition)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find transition named " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find transition named " + sourceName);
 				return;
 			}
 
 			obs_data_t *newSettings = obs_data_create_from_json(settingsJson.c_str());
 			if (newSettings == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Error parsing settings JSON"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Error parsing settings JSON");
 				return;
 			}
 
 			obs_source_update(transition, newSettings);
 			obs_data_release(newSettings);
 
-			out_jsonReturn = Json(Json::object({{"success", true}})).dump();
-		},
-		Qt::BlockingQueuedConnection);
+			out_jsonReturn = JsonWriter::object(JsonKeys::kSuccess, true);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_SET_CURRENT_TRANSITION(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_SET_CURRENT_TRANSITION(std::string sourceName)
 {
-	const auto &param2Value = params["param2"];
-	std::string sourceName = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, sourceName, &out_jsonReturn]() {
 
 			obs_frontend_source_list transitions = {};
@@ -1168,36 +1575,41 @@ void PluginJsHandler::JS_OBS_SET_CURRENT_TRANSITION(const json11::Json &params,
 
 			if (!transition)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find transition named " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find transition named " + sourceName);
 				return;
 			}
 
 			obs_frontend_set_current_transition(transition);
-		},
-		Qt::BlockingQueuedConnection);	
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SAVE_SL_BROWSER_DOCKS(const json11::Json& params, std::string& out_jsonReturn)
+JsTask PluginJsHandler::JS_SAVE_SL_BROWSER_DOCKS()
 {
-	saveSlabsBrowserDocks();
-	out_jsonReturn = Json(Json::object({{"success", true}})).dump();
+	std::string out_jsonReturn;
+
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+
+	co_await onQtThread(mainWindow, [this]() { writeSlabsBrowserDocks(); });
+
+	out_jsonReturn = JsonWriter::object(JsonKeys::kSuccess, true);
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_IS_OBS_STREAMING(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_GET_IS_OBS_STREAMING()
 {
-	out_jsonReturn = Json(Json::object({{"value", obs_frontend_streaming_active()}})).dump();
+	return JsonWriter::object(JsonKeys::kValue, obs_frontend_streaming_active());
 }
 
-void PluginJsHandler::JS_OBS_REMOVE_TRANSITION(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_REMOVE_TRANSITION(std::string sourceName)
 {
-	const auto &param2Value = params["param2"];
-	std::string sourceName = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, sourceName, &out_jsonReturn]() {
 			obs_frontend_source_list transitions = {};
 			obs_frontend_get_transitions(&transitions);
@@ -1217,7 +1629,7 @@ void PluginJsHandler::JS_OBS_REMOVE_TRANSITION(const json11::Json &params, std::
 
 			if (!transition)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find transition named " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find transition named " + sourceName);
 				return;
 			}
 						
@@ -1232,33 +1644,30 @@ void PluginJsHandler::JS_OBS_REMOVE_TRANSITION(const json11::Json &params, std::
 
 					if (idx == -1)
 					{
-						out_jsonReturn = Json(Json::object({{"Transition not found in Qt widget", true}})).dump();
+						out_jsonReturn = JsonWriter::object("Transition not found in Qt widget", true);
 						return;
 					}
 
 					transitions->removeItem(idx);
-					out_jsonReturn = Json(Json::object({{"success", true}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kSuccess, true);
 					return;
 				}
 			}
 
-			out_jsonReturn = Json(Json::object({{"error", "Unable to find transitions widget"}})).dump();	
-		},
-		Qt::BlockingQueuedConnection);
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unable to find transitions widget");	
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_ADD_TRANSITION(const json11::Json& params, std::string& out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_ADD_TRANSITION(std::string id, std::string sourceName)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	std::string id = param2Value.string_value();
-	std::string sourceName = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, id, sourceName, &out_jsonReturn]() {
 
 			obs_frontend_source_list transitions = {};
@@ -1279,7 +1688,7 @@ void PluginJsHandler::JS_OBS_ADD_TRANSITION(const json11::Json& params, std::str
 
 			if (transition != nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Transition already exists named " + sourceName}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Transition already exists named " + sourceName);
 				return;
 			}
 
@@ -1294,7 +1703,7 @@ void PluginJsHandler::JS_OBS_ADD_TRANSITION(const json11::Json& params, std::str
 
 					if (!source)
 					{
-						out_jsonReturn = Json(Json::object({{"error", "Failed to create the object"}})).dump();	
+						out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to create the object");	
 						return;
 					}
 
@@ -1317,32 +1726,33 @@ void PluginJsHandler::JS_OBS_ADD_TRANSITION(const json11::Json& params, std::str
 
 					obs_source_release(source);
 
-					out_jsonReturn = Json(Json::object({{"success", true}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kSuccess, true);
 					return;
 				}
 			}
 
-			out_jsonReturn = Json(Json::object({{"error", "Unable to find transitions widget"}})).dump();	
-		},
-		Qt::BlockingQueuedConnection);
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unable to find transitions widget");	
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_TOGGLE_HIDE_SELF(const json11::Json& params, std::string& out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_TOGGLE_HIDE_SELF(bool boolval)
 {
-	const auto &param2Value = params["param2"];
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-	bool boolval = param2Value.bool_value();
 	
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, boolval, &out_jsonReturn]() {
 			mainWindow->setHidden(boolval);
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_BRING_FRONT(const json11::Json& params, std::string& out_jsonReturn)
+std::string PluginJsHandler::JS_OBS_BRING_FRONT()
 {
 	DWORD currentProcessId = ::GetCurrentProcessId();
 
@@ -1357,167 +1767,180 @@ void PluginJsHandler::JS_OBS_BRING_FRONT(const json11::Json& params, std::string
 			return TRUE;
 		},
 		(LPARAM)currentProcessId);
+
+	return std::string();
 }
 
-void PluginJsHandler::JS_GET_CURRENT_SCENE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_CURRENT_SCENE()
 {
+	std::string out_jsonReturn;
+
+	ObsReadCache &cache = ObsReadCache::instance();
+	std::string cached;
+	uint64_t generation = 0;
+	const bool hit = cache.lookup(ObsReadCache::CURRENT_SCENE, cached, generation);
+
+	if (hit && !cache.crossChecking())
+		co_return cached;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, &out_jsonReturn]() {
 			OBSSourceAutoRelease current_scene_source = obs_frontend_get_current_scene();
 
 			if (current_scene_source == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Empty current scene."}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Empty current scene.");
 				return;
 			}
 
 			auto rawName = obs_source_get_name(current_scene_source);
-			out_jsonReturn = Json(Json::object({{"name", rawName ? rawName : ""}})).dump();
-		},
-		Qt::BlockingQueuedConnection);
+			out_jsonReturn = JsonWriter::object(JsonKeys::kName, rawName ? rawName : "");
+		});
+
+	if (hit)
+		cache.crossCheck(ObsReadCache::CURRENT_SCENE, generation, cached, out_jsonReturn);
+	else
+		cache.store(ObsReadCache::CURRENT_SCENE, generation, out_jsonReturn);
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_CURRENT_SCENE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_CURRENT_SCENE(std::string scene_name)
 {
-	const auto &param2Value = params["param2"];
-	std::string scene_name = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, scene_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease source = obs_get_source_by_name(scene_name.c_str());
 			if (!source)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();			
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);			
 			else if (!obs_source_is_scene(source))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();			
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");			
 			else
 				obs_frontend_set_current_scene(source);
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SCENE_ADD(const json11::Json& params, std::string& out_jsonReturn)
+JsTask PluginJsHandler::JS_SCENE_ADD(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			OBSSourceAutoRelease source = obs_get_source_by_name(source_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!source)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + source_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + source_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
 
 				if (obs_scene_find_source(scene_obj, source_name.c_str()))
 				{
-					out_jsonReturn = Json(Json::object({{"error", "The source is already in the scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The source is already in the scene");
 					return;
 				}
 
 				obs_sceneitem_t *scene_item = obs_scene_add(scene_obj, source);
 				if (!scene_item)
-					out_jsonReturn = Json(Json::object({{"error", "Failed to add source to scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to add source to scene");
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SOURCE_GET_PROPERTIES(const json11::Json& params, std::string& out_jsonReturn)
+JsTask PluginJsHandler::JS_SOURCE_GET_PROPERTIES(std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	std::string source_name = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease existingSource = obs_get_source_by_name(source_name.c_str());
 
 			if (existingSource == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Source not found: " + source_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Source not found: " + source_name);
 				return;
 			}
 
 			obs_properties_t *prp = obs_source_properties(existingSource);
 			obs_data_t *settings = obs_source_get_settings(existingSource);
 
-			Json::array jsonProperties;
+			// Written as it's enumerated, properties of a source with long lists used to be a Json::object per list item
+			JsonWriter writer(out_jsonReturn);
+			writer.beginArray();
 
-			const char *buf = nullptr;
 			for (obs_property_t *p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p))
 			{
-				Json::object propJson;
 				const char *name = obs_property_name(p);
+				writer.beginObject();
 
 				switch (obs_property_get_type(p))
 				{
 				case OBS_PROPERTY_BOOL:
 				{
-					propJson = {{name, obs_data_get_bool(settings, name)}};
+					writer.member(name, obs_data_get_bool(settings, name));
 					break;
 				}
 				case OBS_PROPERTY_INT:
 				{
-					Json::object valueObj;
-					valueObj["type"] = "integer";
-					valueObj["value"] = (int)obs_data_get_int(settings, name);
-					valueObj["min"] = obs_property_int_min(p);
-					valueObj["max"] = obs_property_int_max(p);
-					valueObj["step"] = obs_property_int_step(p);
-					propJson[name] = valueObj;
+					writer.key(name).beginObject();
+					writer.member("type", "integer");
+					writer.member(JsonKeys::kValue, (int)obs_data_get_int(settings, name));
+					writer.member("min", obs_property_int_min(p));
+					writer.member("max", obs_property_int_max(p));
+					writer.member("step", obs_property_int_step(p));
+					writer.endObject();
 					break;
 				}
 				case OBS_PROPERTY_FLOAT:
 				{
-					Json::object valueObj = {{"type", "float"}, {"value", obs_data_get_double(settings, name)}, {"min", obs_property_float_min(p)}, {"max", obs_property_float_max(p)}, {"step", obs_property_float_step(p)}};
-					propJson[name] = valueObj;
+					writer.key(name).beginObject();
+					writer.member("type", "float");
+					writer.member(JsonKeys::kValue, obs_data_get_double(settings, name));
+					writer.member("min", obs_property_float_min(p));
+					writer.member("max", obs_property_float_max(p));
+					writer.member("step", obs_property_float_step(p));
+					writer.endObject();
 					break;
 				}
 				case OBS_PROPERTY_TEXT:
 				{
-					const char *valueBuf = obs_data_get_string(settings, name);
-					std::string value = valueBuf ? valueBuf : "";
-					Json::object valueObj = {{"type", "text"}, {"value", value}};
-					propJson[name] = valueObj;
+					writer.key(name).beginObject().member("type", "text").member(JsonKeys::kValue, obs_data_get_string(settings, name)).endObject();
 					break;
 				}
 				case OBS_PROPERTY_PATH: {
-					const char *valueBuf = obs_data_get_string(settings, name);
-					const char *filterBuf = obs_property_path_filter(p);
-					const char *defaultPathBuf = obs_property_path_default_path(p);
-
-					Json::object valueObj = {{"type", "path"}, {"value", valueBuf ? valueBuf : ""}, {"filter", filterBuf ? filterBuf : ""}, {"default_path", defaultPathBuf ? defaultPathBuf : ""}};
-					propJson[name] = valueObj;
+					writer.key(name).beginObject();
+					writer.member("type", "path");
+					writer.member(JsonKeys::kValue, obs_data_get_string(settings, name));
+					writer.member("filter", obs_property_path_filter(p));
+					writer.member("default_path", obs_property_path_default_path(p));
+					writer.endObject();
 					break;
 				}
 				case OBS_PROPERTY_LIST:
@@ -1537,180 +1960,171 @@ void PluginJsHandler::JS_SOURCE_GET_PROPERTIES(const json11::Json& params, std::
 						String,
 					};
 
-					Json::array itemsArray;
 					size_t items = obs_property_list_item_count(p);
 
 					ListType fieldType = ListType(obs_property_list_type(p));
 					Format format = Format(obs_property_list_format(p));
 
+					writer.key(name).beginObject();
+					writer.member("type", "list");
+					writer.member("field_type", static_cast<int>(fieldType)); // Assuming you want to store the enum value
+					writer.member("format", static_cast<int>(format));
+					writer.key("items").beginArray();
+
 					for (size_t idx = 0; idx < items; ++idx)
 					{
-						const char *itemBuf = obs_property_list_item_name(p, idx);
-						Json::object entry = {{"name", itemBuf ? itemBuf : ""}, {"enabled", !obs_property_list_item_disabled(p, idx)}};
+						writer.beginObject();
+						writer.member(JsonKeys::kName, obs_property_list_item_name(p, idx));
+						writer.member("enabled", !obs_property_list_item_disabled(p, idx));
 
 						switch (format)
 						{
 						case Format::Integer:
-							entry["value_int"] = (int)obs_property_list_item_int(p, idx);
+							writer.member("value_int", (int)obs_property_list_item_int(p, idx));
 							break;
 						case Format::Float:
-							entry["value_float"] = obs_property_list_item_float(p, idx);
+							writer.member("value_float", obs_property_list_item_float(p, idx));
 							break;
 						case Format::String:
-							entry["value_string"] = (itemBuf = obs_property_list_item_string(p, idx)) ? itemBuf : "";
+							writer.member("value_string", obs_property_list_item_string(p, idx));
 							break;
 						}
-						itemsArray.push_back(entry);
-					}
 
-					Json::object listObj = {{"type", "list"},
-								{"field_type", static_cast<int>(fieldType)}, // Assuming you want to store the enum value
-								{"format", static_cast<int>(format)},
-								{"items", itemsArray}};
+						writer.endObject();
+					}
 
-					propJson[name] = listObj;
+					writer.endArray().endObject();
 					break;
 				}
 
 				case OBS_PROPERTY_COLOR_ALPHA:
 				case OBS_PROPERTY_COLOR:
 				{
-					propJson["type"] = "ColorProperty";
-					propJson["field_type"] = (int)obs_property_int_type(p);
-					propJson["value"] = (int)obs_data_get_int(settings, name);
+					writer.member("type", "ColorProperty");
+					writer.member("field_type", (int)obs_property_int_type(p));
+					writer.member(JsonKeys::kValue, (int)obs_data_get_int(settings, name));
 					break;
 				}
 				case OBS_PROPERTY_BUTTON:
-					propJson["type"] = "ButtonProperty";
+					writer.member("type", "ButtonProperty");
 					break;
 				case OBS_PROPERTY_FONT:
 				{
 					obs_data_t *font_obj = obs_data_get_obj(settings, name);
-					propJson["type"] = "FontProperty";
-					propJson["face"] = (buf = obs_data_get_string(font_obj, "face")) != nullptr ? buf : "";
-					propJson["style"] = (buf = obs_data_get_string(font_obj, "style")) != nullptr ? buf : "";
-					propJson["path"] = (buf = obs_data_get_string(font_obj, "path")) != nullptr ? buf : "";
-					propJson["size"] = (int)obs_data_get_int(font_obj, "size");
-					propJson["flags"] = (int)obs_data_get_int(font_obj, "flags");
+					writer.member("type", "FontProperty");
+					writer.member("face", obs_data_get_string(font_obj, "face"));
+					writer.member("style", obs_data_get_string(font_obj, "style"));
+					writer.member(JsonKeys::kPath, obs_data_get_string(font_obj, "path"));
+					writer.member("size", (int)obs_data_get_int(font_obj, "size"));
+					writer.member("flags", (int)obs_data_get_int(font_obj, "flags"));
 					break;
 				}
 				case OBS_PROPERTY_EDITABLE_LIST:
 				{
-					propJson["type"] = "EditableListProperty";
-					propJson["field_type"] = int(obs_property_editable_list_type(p));
-					propJson["filter"] = (buf = obs_property_editable_list_filter(p)) != nullptr ? buf : "";
-					propJson["default_path"] = (buf = obs_property_editable_list_default_path(p)) != nullptr ? buf : "";
+					writer.member("type", "EditableListProperty");
+					writer.member("field_type", int(obs_property_editable_list_type(p)));
+					writer.member("filter", obs_property_editable_list_filter(p));
+					writer.member("default_path", obs_property_editable_list_default_path(p));
 
 					obs_data_array_t *array = obs_data_get_array(settings, name);
 					size_t count = obs_data_array_count(array);
-					json11::Json::array valuesArray;
+					writer.key("values").beginArray();
 
 					for (size_t idx = 0; idx < count; ++idx)
 					{
 						obs_data_t *item = obs_data_array_item(array, idx);
-						valuesArray.push_back((buf = obs_data_get_string(item, "value")) != nullptr ? buf : "");
+						writer.value(obs_data_get_string(item, "value"));
 					}
-					propJson["values"] = valuesArray;
+
+					writer.endArray();
 					break;
 				}
 
 				case OBS_PROPERTY_FRAME_RATE:
 				{
-					propJson["type"] = "FrameRateProperty";
+					writer.member("type", "FrameRateProperty");
 					size_t num_ranges = obs_property_frame_rate_fps_ranges_count(p);
-					json11::Json::array rangesArray;
+					writer.key("ranges").beginArray();
 
 					for (size_t idx = 0; idx < num_ranges; idx++)
 					{
 						auto min = obs_property_frame_rate_fps_range_min(p, idx);
 						auto max = obs_property_frame_rate_fps_range_max(p, idx);
 
-						json11::Json::object minObj;
-						minObj["numerator"] = (int)min.numerator;
-						minObj["denominator"] = (int)min.denominator;
-
-						json11::Json::object maxObj;
-						maxObj["numerator"] = (int)max.numerator;
-						maxObj["denominator"] = (int)max.denominator;
-
-						json11::Json::object rangeObj;
-						rangeObj["minimum"] = minObj;
-						rangeObj["maximum"] = maxObj;
-
-						rangesArray.push_back(rangeObj);
+						writer.beginObject();
+						writer.key("minimum").beginObject().member("numerator", (int)min.numerator).member("denominator", (int)min.denominator).endObject();
+						writer.key("maximum").beginObject().member("numerator", (int)max.numerator).member("denominator", (int)max.denominator).endObject();
+						writer.endObject();
 					}
 
-					propJson["ranges"] = rangesArray;
+					writer.endArray();
 
 					size_t num_options = obs_property_frame_rate_options_count(p);
-					json11::Json::array optionsArray;
+					writer.key("options").beginArray();
 
 					for (size_t idx = 0; idx < num_options; idx++)
 					{
-						auto min = obs_property_frame_rate_fps_range_min(p, idx), max = obs_property_frame_rate_fps_range_max(p, idx);
-						json11::Json::object optionObj;
-
-						optionObj["name"] = (buf = obs_property_frame_rate_option_name(p, idx)) != nullptr ? buf : "";
-						optionObj["description"] = (buf = obs_property_frame_rate_option_description(p, idx)) != nullptr ? buf : "";
-
-						optionsArray.push_back(optionObj);
+						writer.beginObject();
+						writer.member(JsonKeys::kName, obs_property_frame_rate_option_name(p, idx));
+						writer.member("description", obs_property_frame_rate_option_description(p, idx));
+						writer.endObject();
 					}
-					propJson["options"] = optionsArray;
+
+					writer.endArray();
 
 					media_frames_per_second fps = {};
 					if (obs_data_get_frames_per_second(settings, name, &fps, nullptr))
-						propJson["current_fps"] = json11::Json::object{{"numerator", (int)fps.numerator}, {"denominator", (int)fps.denominator}};
+						writer.key("current_fps").beginObject().member("numerator", (int)fps.numerator).member("denominator", (int)fps.denominator).endObject();
 
 					break;
 				}
 				}
 
-				jsonProperties.push_back(propJson);
+				writer.endObject();
 			}
 
-			Json output = jsonProperties;
-			out_jsonReturn = output.dump();
-		},
-		Qt::BlockingQueuedConnection);
+			writer.endArray();
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_CREATE_SCENE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_CREATE_SCENE(std::string scene_name)
 {
-	const auto &param2Value = params["param2"];
-	std::string scene_name = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name.empty() || scene_name.size() > 1024)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid scene name " + scene_name}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid scene name " + scene_name);
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, scene_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease existing = obs_get_source_by_name(scene_name.c_str());
 
 			if (existing != nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Source with that name exists"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Source with that name exists");
 				return;
 			}
 
 			OBSSceneAutoRelease scene = obs_scene_create(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Failed to create scene."}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to create scene.");
 						
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOWNLOAD_ZIP(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_DOWNLOAD_ZIP(std::string url)
 {
-	const auto &param2Value = params["param2"];
-	std::string url = param2Value.string_value();
+	std::string out_jsonReturn;
+
 	std::wstring folderPath = getDownloadsDir();
 
 	if (!folderPath.empty())
@@ -1741,26 +2155,22 @@ void PluginJsHandler::JS_DOWNLOAD_ZIP(const Json &params, std::string &out_jsonR
 
 			if (WindowsFunctions::Unzip(wstring_to_utf8(zipFilepath), filepaths))
 			{
-				// Build json string now
-				Json::array json_array;
+				JsonWriter writer(out_jsonReturn);
+				writer.beginArray();
 
 				for (const auto &filepath : filepaths)
-				{
-					Json::object obj;
-					obj["path"] = filepath;
-					json_array.push_back(obj);
-				}
+					writer.beginObject().member(JsonKeys::kPath, filepath).endObject();
 
-				out_jsonReturn = Json(json_array).dump();
+				writer.endArray();
 			}
 			else
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Unzip file failed"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unzip file failed");
 			}
 		}
 		else
 		{
-			out_jsonReturn = Json(Json::object({{"error", "Http download file failed"}})).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Http download file failed");
 		}
 
 		// zip file itself not needed
@@ -1768,23 +2178,22 @@ void PluginJsHandler::JS_DOWNLOAD_ZIP(const Json &params, std::string &out_jsonR
 	}
 	else
 	{
-		out_jsonReturn = Json(Json::object({{"error", "File system can't access Local AppData folder"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "File system can't access Local AppData folder");
 	}
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DOWNLOAD_FILE(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_DOWNLOAD_FILE(std::string url, std::string filename)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
+	std::string out_jsonReturn;
 
-	std::string url = param2Value.string_value();
-	std::string filename = param3Value.string_value();
 	std::wstring folderPath = getDownloadsDir();
 
 	if (filename.empty() || url.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid params"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		return out_jsonReturn;
 	}
 
 	auto wstring_to_utf8 = [](const std::wstring &str) {
@@ -1815,25 +2224,26 @@ void PluginJsHandler::JS_DOWNLOAD_FILE(const Json &params, std::string &out_json
 		CreateDirectoryW(subFolderPath.c_str(), NULL);
 
 		if (WindowsFunctions::DownloadFile(url, wstring_to_utf8(downloadPath)))
-			out_jsonReturn = Json(Json::object({{"path", downloadPath}})).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kPath, wstring_to_utf8(downloadPath));
 		else
-			out_jsonReturn = Json(Json::object({{"error", "Http download file failed"}})).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Http download file failed");
 	}
 	else
 	{
-		out_jsonReturn = Json(Json::object({{"error", "File system can't access Local AppData folder"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "File system can't access Local AppData folder");
 	}
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_INSTALL_FONT(const json11::Json& params, std::string& out_jsonReturn)
+std::string PluginJsHandler::JS_INSTALL_FONT(std::string filepath)
 {
-	const auto &param2Value = params["param2"];
-	std::string filepath = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	if (filepath.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid param"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid param");
+		return out_jsonReturn;
 	}
 
 	if (WindowsFunctions::InstallFont(filepath.c_str()))
@@ -1856,34 +2266,33 @@ void PluginJsHandler::JS_INSTALL_FONT(const json11::Json& params, std::string& o
 			}
 			catch (const std::filesystem::filesystem_error &e)
 			{
-				out_jsonReturn = Json(Json::object({{"error", e.what()}})).dump();
-				return;
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, e.what());
+				return out_jsonReturn;
 			}
 
-			out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
 		}
 		else
 		{
-			out_jsonReturn = Json(Json::object({{"error", "QFontDatabase addApplicationFont failed"}})).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "QFontDatabase addApplicationFont failed");
 		}
 	}
 	else
 	{
-		out_jsonReturn = Json(Json::object({{"error", "WinApi AddFontResourceA failed"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "WinApi AddFontResourceA failed");
 	}
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_READ_FILE(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_READ_FILE(std::string filepath)
 {
-	const auto &param2Value = params["param2"];
+	std::string out_jsonReturn;
 
-	std::string filepath = param2Value.string_value();
 	std::string filecontents;
 
 	std::ifstream file(filepath, std::ios::binary | std::ios::ate);
 
-	Json ret;
-
 	if (file)
 	{
 		try
@@ -1895,44 +2304,43 @@ void PluginJsHandler::JS_READ_FILE(const Json &params, std::string &out_jsonRetu
 			// Check if file size is 1MB or higher
 			if (fileSize >= 1048576)
 			{
-				ret = Json::object({{"error", "File size is 1MB or higher"}});
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "File size is 1MB or higher");
 			}
 			else
 			{
 				std::stringstream buffer;
 				buffer << file.rdbuf();
 				filecontents = buffer.str();
-				ret = Json::object({{"contents", filecontents}});
+				out_jsonReturn = JsonWriter::object("contents", filecontents);
 			}
 		}
 		catch (...)
 		{
-			ret = Json::object({{"error", "Unable to read file. Checking for windows errors: '" + std::to_string(GetLastError()) + "'"}});
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unable to read file. Checking for windows errors: '" + std::to_string(GetLastError()) + "'");
 		}
 	}
 	else
 	{
-		ret = Json::object({{"error", "Unable to open file. Checking for windows errors: '" + std::to_string(GetLastError()) + "'"}});
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unable to open file. Checking for windows errors: '" + std::to_string(GetLastError()) + "'");
 	}
 
-	out_jsonReturn = ret.dump();
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DELETE_FILES(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_DELETE_FILES(std::string filepaths_jsonStr)
 {
-	Json ret;
+	std::string out_jsonReturn;
+
 	std::vector<std::string> errors;
 	std::vector<std::string> success;
 
-	const auto &param2Value = params["param2"];
-
 	std::string err;
-	Json jsonArray = Json::parse(params["param2"].string_value().c_str(), err);
+	Json jsonArray = Json::parse(filepaths_jsonStr, err);
 
 	if (!err.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid parameter: " + err}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid parameter: " + err);
+		return out_jsonReturn;
 	}
 
 	const auto &filepaths = jsonArray.array_items();
@@ -1974,12 +2382,25 @@ void PluginJsHandler::JS_DELETE_FILES(const Json &params, std::string &out_jsonR
 		}
 	}
 
-	out_jsonReturn = Json(Json::object({{"success", success}, {"errors", errors}})).dump();
+	JsonWriter writer(out_jsonReturn);
+	writer.beginObject().key(JsonKeys::kSuccess).beginArray();
+
+	for (const std::string &filepath : success)
+		writer.value(filepath);
+
+	writer.endArray().key("errors").beginArray();
+
+	for (const std::string &error : errors)
+		writer.value(error);
+
+	writer.endArray().endObject();
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_DROP_FOLDER(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_DROP_FOLDER(std::string filepath)
 {
-	const auto &filepath = params["param2"].string_value();
+	std::string out_jsonReturn;
 
 	std::filesystem::path downloadsDir = std::filesystem::path(getDownloadsDir());
 	std::filesystem::path fullPath = downloadsDir / filepath;
@@ -1988,7 +2409,7 @@ void PluginJsHandler::JS_DROP_FOLDER(const Json &params, std::string &out_jsonRe
 	// Check if filepath contains relative components that move outside the downloads directory
 	if (normalizedPath.string().find(downloadsDir.string()) != 0)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid path: " + filepath}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid path: " + filepath);
 	}
 	else
 	{
@@ -1998,13 +2419,17 @@ void PluginJsHandler::JS_DROP_FOLDER(const Json &params, std::string &out_jsonRe
 		}
 		catch (const std::filesystem::filesystem_error &e)
 		{
-			out_jsonReturn = Json(Json::object({{"error", "Failed to delete '" + filepath + "': " + e.what()}})).dump();
+			out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to delete '" + filepath + "': " + e.what());
 		}
 	}
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_LOGS_REPORT_STRING(const json11::Json& params, std::string& out_jsonReturn)
+std::string PluginJsHandler::JS_GET_LOGS_REPORT_STRING()
 {
+	std::string out_jsonReturn;
+
 	std::string fullReport;
 
 	namespace fs = std::filesystem;
@@ -2094,64 +2519,70 @@ void PluginJsHandler::JS_GET_LOGS_REPORT_STRING(const json11::Json& params, std:
 	catch (const fs::filesystem_error &e)
 	{
 		std::string err = e.what();
-		out_jsonReturn = Json(Json::object({{"error", err}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, err);
 	}
 	catch (const std::exception &e)
 	{
 		std::string err = e.what();
-		out_jsonReturn = Json(Json::object({{"error", err}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, err);
 	}
 	catch (...)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Unknown Exception"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Unknown Exception");
 	}
 
 	if (fullReport.empty())
-		out_jsonReturn = Json(Json::object({{"error", "Empty Report"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Empty Report");
 	else
-		out_jsonReturn = Json(Json::object({{"content", fullReport}})).dump();
+		out_jsonReturn = JsonWriter::object("content", fullReport);
+
+	return out_jsonReturn;
 }
 
 
-void PluginJsHandler::JS_QUERY_DOWNLOADS_FOLDER(const Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_QUERY_DOWNLOADS_FOLDER()
 {
+	std::string out_jsonReturn;
+
 	std::wstring downloadsFolderFullPath = getDownloadsDir();
-	std::vector<Json> pathsList;
 
 	try
 	{
+		std::string pathsJson;
+		JsonWriter writer(pathsJson);
+		writer.beginArray();
+
 		// Use recursive_directory_iterator for recursive traversal
 		for (const auto &entry : std::filesystem::recursive_directory_iterator(downloadsFolderFullPath))
-			pathsList.push_back(entry.path().generic_string());
+			writer.value(entry.path().generic_string());
 
-		out_jsonReturn = Json(Json::array(pathsList)).dump();
+		writer.endArray();
+		out_jsonReturn = std::move(pathsJson);
 	}
 	catch (const std::filesystem::filesystem_error &e)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Failed to query downloads folder: " + std::string(e.what())}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to query downloads folder: " + std::string(e.what()));
 	}
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_SOURCE_CREATE(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_SOURCE_CREATE(std::string id, std::string name, std::string settings_jsonStr, std::string hotkey_data_jsonStr, bool raw)
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, this, &params, &out_jsonReturn]() {
-			const auto &id = params["param2"].string_value();
-			const auto &name = params["param3"].string_value();
-			const auto &settings_jsonStr = params["param4"].string_value();
-			const auto &hotkey_data_jsonStr = params["param5"].string_value();
-
+	co_await onQtThread(mainWindow,
+		[mainWindow, this, &id, &name, &settings_jsonStr, &hotkey_data_jsonStr, raw, &out_jsonReturn]() {
 			// Name is also the guid, duplicates can't exist
 			//	see "bool AddNew(QWidget *parent, const char *id, const char *name," in obs gui code
 			OBSSourceAutoRelease existingSource = obs_get_source_by_name(name.c_str());
 
 			if (existingSource != nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "name already exists, " + name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "name already exists, " + name);
 				return;
 			}
 
@@ -2159,7 +2590,7 @@ void PluginJsHandler::JS_OBS_SOURCE_CREATE(const Json &params, std::string &out_
 
 			if (scene == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Empty current scene."}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Empty current scene.");
 				return;
 			}
 
@@ -2173,52 +2604,62 @@ void PluginJsHandler::JS_OBS_SOURCE_CREATE(const Json &params, std::string &out_
 
 			if (!source)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "obs_source_create returned null"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "obs_source_create returned null");
 				return;
 			}
 
 			obs_data_t *settingsSource = obs_source_get_settings(source);
 
-			Json jsonReturnValue = Json::object({{"settings", Json(obs_data_get_json(settingsSource))},
-							     {"audio_mixers", Json(std::to_string(obs_source_get_audio_mixers(source)))},
-							     {"deinterlace_mode", Json(std::to_string(obs_source_get_deinterlace_mode(source)))},
-							     {"deinterlace_field_order", Json(std::to_string(obs_source_get_deinterlace_field_order(source)))}});
+			const char *settings = obs_data_get_json(settingsSource);
+
+			JsonWriter writer(out_jsonReturn);
+			writer.beginObject().key("settings");
+
+			// The settings blob is usually the biggest part, raw splices it in as it came from libobs
+			if (raw)
+				writer.raw(settings ? settings : "");
+			else
+				writer.value(settings);
+
+			writer.member("audio_mixers", std::to_string(obs_source_get_audio_mixers(source)))
+				.member("deinterlace_mode", std::to_string(obs_source_get_deinterlace_mode(source)))
+				.member("deinterlace_field_order", std::to_string(obs_source_get_deinterlace_field_order(source)))
+				.endObject();
 
-			out_jsonReturn = jsonReturnValue.dump();
 			obs_data_release(settingsSource);
 
 			obs_scene_t *scene_obj = obs_scene_from_source(scene);
 
 			if (obs_scene_find_source(scene_obj, name.c_str()))
 			{
-				out_jsonReturn = Json(Json::object({{"error", "The source is already in the scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The source is already in the scene");
 				return;
 			}
 
 			obs_sceneitem_t *scene_item = obs_scene_add(scene_obj, source);
 			if (!scene_item)
-				out_jsonReturn = Json(Json::object({{"error", "Failed to add source to scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to add source to scene");
 
 			obs_source_release(source);
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_OBS_SOURCE_DESTROY(const Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_OBS_SOURCE_DESTROY(std::string name)
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, this, params, &out_jsonReturn]() {
-			const auto &name = params["param2"].string_value();
-
+	co_await onQtThread(mainWindow,
+		[mainWindow, this, name, &out_jsonReturn]() {
 			OBSSourceAutoRelease src = obs_get_source_by_name(name.c_str());
 
 			if (src == nullptr)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Can't find source with name " + name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Can't find source with name " + name);
 				return;
 			}
 
@@ -2248,7 +2689,7 @@ void PluginJsHandler::JS_OBS_SOURCE_DESTROY(const Json &params, std::string &out
 
 				if (getSceneCount() < 2)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "You cannot remove the last scene in the collection."}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "You cannot remove the last scene in the collection.");
 					return;
 				}
 
@@ -2279,88 +2720,97 @@ void PluginJsHandler::JS_OBS_SOURCE_DESTROY(const Json &params, std::string &out
 			{
 				obs_source_remove(src);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENE_COLLECTIONS(const json11::Json& params, std::string& out_jsonReturn)
+std::string PluginJsHandler::JS_GET_SCENE_COLLECTIONS()
 {
+	std::string out_jsonReturn;
+
+	ObsReadCache &cache = ObsReadCache::instance();
+	std::string cached;
+	uint64_t generation = 0;
+	const bool hit = cache.lookup(ObsReadCache::SCENE_COLLECTIONS, cached, generation);
+
+	if (hit && !cache.crossChecking())
+	{
+		out_jsonReturn = std::move(cached);
+		return out_jsonReturn;
+	}
+
 	char **scene_collections = obs_frontend_get_scene_collections();
 
-	std::vector<Json> result;
+	JsonWriter writer(out_jsonReturn);
+	writer.beginArray();
 
 	for (int i = 0; scene_collections[i] != nullptr; ++i)
-		result.push_back(Json::object{{"name", scene_collections[i]}});
+		writer.beginObject().member(JsonKeys::kName, scene_collections[i]).endObject();
+
+	writer.endArray();
+	bfree(scene_collections);
 
-	// Convert the panelInfo vector to a Json object and dump string
-	Json ret = result;
-	out_jsonReturn = ret.dump();
+	if (hit)
+		cache.crossCheck(ObsReadCache::SCENE_COLLECTIONS, generation, cached, out_jsonReturn);
+	else
+		cache.store(ObsReadCache::SCENE_COLLECTIONS, generation, out_jsonReturn);
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_CURRENT_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_GET_CURRENT_SCENE_COLLECTION()
 {
-	Json ret = Json::object{{"name", obs_frontend_get_current_scene_collection()}};
-	out_jsonReturn = ret.dump();
+	return JsonWriter::object(JsonKeys::kName, obs_frontend_get_current_scene_collection());
 }
 
-void PluginJsHandler::JS_SET_CURRENT_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_SET_CURRENT_SCENE_COLLECTION(std::string name)
 {
-	const auto &name = params["param2"].string_value();
-
 	if (name.empty())
-	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid param"}})).dump();
-		return;
-	}
+		return JsonWriter::object(JsonKeys::kError, "Invalid param");
 
 	obs_frontend_set_current_scene_collection(name.c_str());
+	return std::string();
 }
 
-void PluginJsHandler::JS_ADD_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_ADD_SCENE_COLLECTION(std::string name)
 {
-	const auto &name = params["param2"].string_value();
+	std::string out_jsonReturn;
 
 	if (name.empty())
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Invalid param"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid param");
+		return out_jsonReturn;
 	}
 
 	if (!obs_frontend_add_scene_collection(name.c_str()))
-		out_jsonReturn = Json(Json::object({{"error", "Obs function failed"}})).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Obs function failed");
 	else
-		out_jsonReturn = Json(Json::object{{"status", "success"}}).dump();
+		out_jsonReturn = JsonWriter::object(JsonKeys::kStatus, "success");
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_POS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_POS(std::string scene_name, std::string source_name, float x, float y)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-	const auto &param5Value = params["param5"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	float x = (float)param4Value.number_value();
-	float y = (float)param5Value.number_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[mainWindow, scene_name, source_name, x, y, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2368,7 +2818,7 @@ void PluginJsHandler::JS_SET_SCENEITEM_POS(const json11::Json &params, std::stri
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed find the source in that scene");
 					return;
 				}
 
@@ -2377,37 +2827,31 @@ void PluginJsHandler::JS_SET_SCENEITEM_POS(const json11::Json &params, std::stri
 				pos.y = y;
 				obs_sceneitem_set_pos(scene_item, &pos);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_ROT(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_ROT(std::string scene_name, std::string source_name, float rotation)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	float rotation = (float)param4Value.number_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, rotation, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2415,49 +2859,37 @@ void PluginJsHandler::JS_SET_SCENEITEM_ROT(const json11::Json &params, std::stri
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed find the source in that scene");
 					return;
 				}
 
 				obs_sceneitem_set_rot(scene_item, rotation);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_CROP(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_CROP(std::string scene_name, std::string source_name, int left, int top, int right, int bottom)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-	const auto &param5Value = params["param5"];
-	const auto &param6Value = params["param6"];
-	const auto &param7Value = params["param7"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	int left = param4Value.int_value();
-	int top = param5Value.int_value();
-	int right = param6Value.int_value();
-	int bottom = param7Value.int_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, left, top, right, bottom, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2465,44 +2897,38 @@ void PluginJsHandler::JS_SET_SCENEITEM_CROP(const json11::Json &params, std::str
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed find the source in that scene");
 					return;
 				}
 
 				struct obs_sceneitem_crop crop = {left, top, right, bottom};
 				obs_sceneitem_set_crop(scene_item, &crop);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_SCALE_FILTER(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_SCALE_FILTER(std::string scene_name, std::string source_name, int scale_type)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	int scale_type = param4Value.int_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, scale_type, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2510,43 +2936,40 @@ void PluginJsHandler::JS_SET_SCENEITEM_SCALE_FILTER(const json11::Json &params,
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				obs_sceneitem_set_scale_filter(scene_item, (obs_scale_type)scale_type);
+
+				// libobs has no signal for this one
+				SceneGraph::instance().markChanged(scene_name);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_BLENDING_MODE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_BLENDING_MODE(std::string scene_name, std::string source_name, int blending_type)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	int blending_type = param4Value.int_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, blending_type, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2554,43 +2977,40 @@ void PluginJsHandler::JS_SET_SCENEITEM_BLENDING_MODE(const json11::Json &params,
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				obs_sceneitem_set_blending_mode(scene_item, (obs_blending_type)blending_type);
+
+				// libobs has no signal for this one
+				SceneGraph::instance().markChanged(scene_name);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCENEITEM_BLENDING_METHOD(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SET_SCENEITEM_BLENDING_METHOD(std::string scene_name, std::string source_name, int blending_method)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	int blending_method = param4Value.int_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, blending_method, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2598,46 +3018,264 @@ void PluginJsHandler::JS_SET_SCENEITEM_BLENDING_METHOD(const json11::Json &param
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_set_blending_method exists and accepts an enum type for blending method.
 				obs_sceneitem_set_blending_method(scene_item, (obs_blending_method)blending_method);
+
+				// libobs has no signal for this one
+				SceneGraph::instance().markChanged(scene_name);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
+}
+
+// Qt thread, inside the scene's atomic update, the properties the entry doesn't have are left alone
+static void applySceneItemTransform(obs_sceneitem_t *scene_item, const JsonNode &entry)
+{
+	// Interned, a call can carry hundreds of entries
+	static constexpr JsonKey kPos{"pos"}, kRot{"rot"}, kScale{"scale"}, kCrop{"crop"}, kBounds{"bounds"}, kFilter{"filter"}, kBlend{"blend"}, kBlendMethod{"blendMethod"};
+	static constexpr JsonKey kType{"type"}, kAlignment{"alignment"}, kLeft{"left"}, kTop{"top"}, kRight{"right"}, kBottom{"bottom"};
+	using JsonKeys::kX;
+	using JsonKeys::kY;
+
+	if (const JsonNode &pos = entry[kPos]; pos.is_object())
+	{
+		vec2 value;
+		vec2_set(&value, float(pos[kX].number_value()), float(pos[kY].number_value()));
+		obs_sceneitem_set_pos(scene_item, &value);
+	}
+
+	if (const JsonNode &rot = entry[kRot]; rot.is_number())
+		obs_sceneitem_set_rot(scene_item, float(rot.number_value()));
+
+	if (const JsonNode &scale = entry[kScale]; scale.is_object())
+	{
+		vec2 value;
+		vec2_set(&value, float(scale[kX].number_value()), float(scale[kY].number_value()));
+		obs_sceneitem_set_scale(scene_item, &value);
+	}
+
+	if (const JsonNode &crop = entry[kCrop]; crop.is_object())
+	{
+		struct obs_sceneitem_crop value = {crop[kLeft].int_value(), crop[kTop].int_value(), crop[kRight].int_value(), crop[kBottom].int_value()};
+		obs_sceneitem_set_crop(scene_item, &value);
+	}
+
+	if (const JsonNode &bounds = entry[kBounds]; bounds.is_object())
+	{
+		// Same inside bounds, a size alone mustn't reset its type to none or its alignment to center
+		if (const JsonNode &type = bounds[kType]; type.is_number())
+			obs_sceneitem_set_bounds_type(scene_item, (obs_bounds_type)type.int_value());
+
+		const JsonNode &x = bounds[kX];
+		const JsonNode &y = bounds[kY];
+
+		if (x.is_number() || y.is_number())
+		{
+			vec2 value;
+			obs_sceneitem_get_bounds(scene_item, &value);
+
+			if (x.is_number())
+				value.x = float(x.number_value());
+
+			if (y.is_number())
+				value.y = float(y.number_value());
+
+			obs_sceneitem_set_bounds(scene_item, &value);
+		}
+
+		if (const JsonNode &alignment = bounds[kAlignment]; alignment.is_number())
+			obs_sceneitem_set_bounds_alignment(scene_item, uint32_t(alignment.int_value()));
+	}
+
+	if (const JsonNode &filter = entry[kFilter]; filter.is_number())
+		obs_sceneitem_set_scale_filter(scene_item, (obs_scale_type)filter.int_value());
+
+	if (const JsonNode &blend = entry[kBlend]; blend.is_number())
+		obs_sceneitem_set_blending_mode(scene_item, (obs_blending_type)blend.int_value());
+
+	if (const JsonNode &blendMethod = entry[kBlendMethod]; blendMethod.is_number())
+		obs_sceneitem_set_blending_method(scene_item, (obs_blending_method)blendMethod.int_value());
+}
+
+JsTask PluginJsHandler::JS_SET_SCENEITEM_TRANSFORMS(std::string transforms)
+{
+	std::string out_jsonReturn;
+
+	JsonDocument doc;
+	std::string err;
+
+	if (!doc.parse(transforms, err) || !doc.root().is_array())
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Invalid params");
+		co_return out_jsonReturn;
+	}
+
+	const JsonNode &entries = doc.root();
+
+	if (entries.size() > kMaxBatchCalls)
+	{
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Too many transforms in one call");
+		co_return out_jsonReturn;
+	}
+
+	// Entries grouped by scene in the order the scenes first show up, each scene is resolved and locked once
+	struct SceneGroup
+	{
+		std::string name;
+		std::vector<size_t> entries;
+	};
+
+	std::vector<SceneGroup> groups;
+	std::vector<std::string> errors(entries.size());
+	static constexpr JsonKey kScene{"scene"}, kItem{"item"};
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const std::string_view scene_name = entries[i][kScene].string_value();
+		const std::string_view source_name = entries[i][kItem].string_value();
+
+		if (!entries[i].is_object() || scene_name.empty() || source_name.empty())
+		{
+			errors[i] = "Entry needs a scene and an item";
+			continue;
+		}
+
+		if (scene_name == source_name)
+		{
+			errors[i] = "Scene and source inputs have same name";
+			continue;
+		}
+
+		auto group = std::find_if(groups.begin(), groups.end(), [scene_name](const SceneGroup &candidate) { return candidate.name == scene_name; });
+
+		if (group == groups.end())
+			group = groups.insert(groups.end(), SceneGroup{std::string(scene_name), {}});
+
+		group->entries.push_back(i);
+	}
+
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+
+	co_await onQtThread(mainWindow, [&groups, &entries, &errors]() {
+		for (const SceneGroup &group : groups)
+		{
+			OBSSourceAutoRelease scene = obs_get_source_by_name(group.name.c_str());
+
+			if (!scene || !obs_source_is_scene(scene))
+			{
+				const std::string error = !scene ? "Did not find an object with name " + group.name : "The object found is not a scene";
+
+				for (const size_t i : group.entries)
+					errors[i] = error;
+
+				continue;
+			}
+
+			struct AtomicUpdate
+			{
+				const SceneGroup &group;
+				const JsonNode &entries;
+				std::vector<std::string> &errors;
+			} update{group, entries, errors};
+
+			obs_scene_atomic_update(
+				obs_scene_from_source(scene),
+				[](void *param, obs_scene_t *scene_obj) {
+					AtomicUpdate *update = reinterpret_cast<AtomicUpdate *>(param);
+
+					for (const size_t i : update->group.entries)
+					{
+						const JsonNode &entry = update->entries[i];
+						obs_sceneitem_t *scene_item = obs_scene_find_source(scene_obj, std::string(entry[kItem].string_value()).c_str());
+
+						if (!scene_item)
+						{
+							update->errors[i] = "Failed to find the source in that scene";
+							continue;
+						}
+
+						applySceneItemTransform(scene_item, entry);
+					}
+				},
+				&update);
+
+			// Transforms are signalled on the next video tick, filter and blending aren't at all
+			SceneGraph::instance().markChanged(group.name);
+		}
+	});
+
+	JsonWriter writer(out_jsonReturn);
+	writer.beginArray();
+
+	for (const std::string &error : errors)
+	{
+		if (error.empty())
+			writer.value(nullptr);
+		else
+			writer.beginObject().member(JsonKeys::kError, error).endObject();
+	}
+
+	writer.endArray();
+	co_return out_jsonReturn;
+}
+
+std::string PluginJsHandler::JS_SCENE_GRAPH_SNAPSHOT()
+{
+	std::string out_jsonReturn;
+	JsonWriter writer(out_jsonReturn);
+	SceneGraph::instance().writeSnapshot(writer);
+	return out_jsonReturn;
+}
+
+std::string PluginJsHandler::JS_SCENE_GRAPH_DIFF(double sinceVersion)
+{
+	// Versions count up from 0, anything else gets the full snapshot
+	const uint64_t since = sinceVersion >= 0 && sinceVersion < 9007199254740992.0 ? uint64_t(sinceVersion) : UINT64_MAX;
+
+	std::string out_jsonReturn;
+	JsonWriter writer(out_jsonReturn);
+	SceneGraph::instance().writeDiff(writer, since);
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SET_SCALE(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_OBS_SUBSCRIBE_EVENTS(std::string classes)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-	const auto &param4Value = params["param4"];
-	const auto &param5Value = params["param5"];
+	// Checked and subscribed under the cancel lock, a cancel for this page can't land in between and leave it subscribed
+	std::lock_guard<std::mutex> grd(m_cancelMtx);
+	auto cancelled = m_cancelledBefore.find(t_currentBrowserId);
+
+	if (cancelled != m_cancelledBefore.end() && t_currentNavigation < cancelled->second)
+		return JsonWriter::object(JsonKeys::kError, "Page navigated away");
+
+	// Events are pushed to the callback this call was made with
+	return ObsEventChannel::instance().subscribe(t_currentBrowserId, t_currentNavigation, t_currentFuncId, classes);
+}
 
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
-	float x_scale = (float)param4Value.number_value();
-	float y_scale = (float)param5Value.number_value();
+JsTask PluginJsHandler::JS_SET_SCALE(std::string scene_name, std::string source_name, float x_scale, float y_scale)
+{
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, x_scale, y_scale, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2645,7 +3283,7 @@ void PluginJsHandler::JS_SET_SCALE(const json11::Json &params, std::string &out_
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
@@ -2653,35 +3291,31 @@ void PluginJsHandler::JS_SET_SCALE(const json11::Json &params, std::string &out_
 				vec2 scale = {x_scale, y_scale};
 				obs_sceneitem_set_scale(scene_item, &scale);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_POS(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_POS(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2689,44 +3323,40 @@ void PluginJsHandler::JS_GET_SCENEITEM_POS(const json11::Json &params, std::stri
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_get_pos exists and retrieves x and y position values.
 				vec2 position;
 				obs_sceneitem_get_pos(scene_item, &position);
-				out_jsonReturn = Json(Json::object({{"x", position.x}, {"y", position.y}})).dump();
+				JsonWriter(out_jsonReturn).beginObject().member(JsonKeys::kX, position.x).member(JsonKeys::kY, position.y).endObject();
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_ROT(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_ROT(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2734,43 +3364,39 @@ void PluginJsHandler::JS_GET_SCENEITEM_ROT(const json11::Json &params, std::stri
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_get_rot exists and retrieves the rotation value.
 				float rotation = obs_sceneitem_get_rot(scene_item);
-				out_jsonReturn = Json(Json::object({{"rotation", rotation}})).dump();
+				out_jsonReturn = JsonWriter::object("rotation", rotation);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_CROP(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_CROP(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2778,7 +3404,7 @@ void PluginJsHandler::JS_GET_SCENEITEM_CROP(const json11::Json &params, std::str
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
@@ -2786,63 +3412,56 @@ void PluginJsHandler::JS_GET_SCENEITEM_CROP(const json11::Json &params, std::str
 				obs_sceneitem_crop crop_values;
 				obs_sceneitem_get_crop(scene_item, &crop_values);
 
-				out_jsonReturn = Json(Json::object({{"left", crop_values.left}, {"right", crop_values.right}, {"top", crop_values.top}, {"bottom", crop_values.bottom}})).dump();
+				JsonWriter(out_jsonReturn)
+					.beginObject()
+					.member("left", crop_values.left)
+					.member("right", crop_values.right)
+					.member("top", crop_values.top)
+					.member("bottom", crop_values.bottom)
+					.endObject();
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SOURCE_DIMENSIONS(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_GET_SOURCE_DIMENSIONS(std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	std::string source_name = param2Value.string_value();
+	// Thread safe in libobs, no Qt hop needed. Not cached, async sources (webcams, media) change size without a signal
+	OBSSourceAutoRelease source = obs_get_source_by_name(source_name.c_str());
 
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[source_name, &out_jsonReturn]() {
-			OBSSourceAutoRelease source = obs_get_source_by_name(source_name.c_str());
-			if (!source)
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find a source with name " + source_name}})).dump();
-				return;
-			}
+	if (!source)
+		return JsonWriter::object(JsonKeys::kError, "Did not find a source with name " + source_name);
 
-			uint32_t width = obs_source_get_width(source);
-			uint32_t height = obs_source_get_height(source);
+	uint32_t width = obs_source_get_width(source);
+	uint32_t height = obs_source_get_height(source);
 
-			out_jsonReturn = Json(Json::object({{"width", static_cast<int>(width)}, {"height", static_cast<int>(height)}})).dump();
-		},
-		Qt::BlockingQueuedConnection);
+	std::string out_jsonReturn;
+	JsonWriter(out_jsonReturn).beginObject().member(JsonKeys::kWidth, static_cast<int>(width)).member(JsonKeys::kHeight, static_cast<int>(height)).endObject();
+	return out_jsonReturn;
 }
 
 
-void PluginJsHandler::JS_GET_SCALE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCALE(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2850,7 +3469,7 @@ void PluginJsHandler::JS_GET_SCALE(const json11::Json &params, std::string &out_
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
@@ -2858,37 +3477,33 @@ void PluginJsHandler::JS_GET_SCALE(const json11::Json &params, std::string &out_
 				vec2 scale_values;
 				obs_sceneitem_get_scale(scene_item, &scale_values);
 
-				out_jsonReturn = Json(Json::object({{"x", scale_values.x}, {"y", scale_values.y}})).dump();
+				JsonWriter(out_jsonReturn).beginObject().member(JsonKeys::kX, scale_values.x).member(JsonKeys::kY, scale_values.y).endObject();
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_SCALE_FILTER(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_SCALE_FILTER(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2896,43 +3511,39 @@ void PluginJsHandler::JS_GET_SCENEITEM_SCALE_FILTER(const json11::Json &params,
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_get_scale_filter exists and retrieves the scale filter value.
 				int scale_filter = static_cast<int>(obs_sceneitem_get_scale_filter(scene_item));
-				out_jsonReturn = Json(Json::object({{"scale_filter", scale_filter}})).dump();
+				out_jsonReturn = JsonWriter::object("scale_filter", scale_filter);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_BLENDING_MODE(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_BLENDING_MODE(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2940,43 +3551,39 @@ void PluginJsHandler::JS_GET_SCENEITEM_BLENDING_MODE(const json11::Json &params,
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_get_blending_mode exists and retrieves the blending mode value.
 				int blending_mode = static_cast<int>(obs_sceneitem_get_blending_mode(scene_item));
-				out_jsonReturn = Json(Json::object({{"blending_mode", blending_mode}})).dump();
+				out_jsonReturn = JsonWriter::object("blending_mode", blending_mode);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_SCENEITEM_BLENDING_METHOD(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_GET_SCENEITEM_BLENDING_METHOD(std::string scene_name, std::string source_name)
 {
-	const auto &param2Value = params["param2"];
-	const auto &param3Value = params["param3"];
-
-	std::string scene_name = param2Value.string_value();
-	std::string source_name = param3Value.string_value();
+	std::string out_jsonReturn;
 
 	if (scene_name == source_name)
 	{
-		out_jsonReturn = Json(Json::object({{"error", "Scene and source inputs have same name"}})).dump();
-		return;
+		out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Scene and source inputs have same name");
+		co_return out_jsonReturn;
 	}
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
 	// This code is executed in the context of the QMainWindow's thread.
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, source_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 			else if (!obs_source_is_scene(scene))
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 			else
 			{
 				obs_scene_t *scene_obj = obs_scene_from_source(scene);
@@ -2984,37 +3591,36 @@ void PluginJsHandler::JS_GET_SCENEITEM_BLENDING_METHOD(const json11::Json &param
 
 				if (!scene_item)
 				{
-					out_jsonReturn = Json(Json::object({{"error", "Failed to find the source in that scene"}})).dump();
+					out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Failed to find the source in that scene");
 					return;
 				}
 
 				// Assuming obs_sceneitem_get_blending_method exists and retrieves the blending method value.
 				int blending_method = static_cast<int>(obs_sceneitem_get_blending_method(scene_item));
-				out_jsonReturn = Json(Json::object({{"blending_method", blending_method}})).dump();
+				out_jsonReturn = JsonWriter::object("blending_method", blending_method);
 			}
-		},
-		Qt::BlockingQueuedConnection);
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_SCENE_GET_SOURCES(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_SCENE_GET_SOURCES(std::string scene_name)
 {
-	const auto &param2Value = params["param2"];
-	std::string scene_name = param2Value.string_value();
+	std::string out_jsonReturn;
 
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[scene_name, &out_jsonReturn]() {
 			OBSSourceAutoRelease scene = obs_get_source_by_name(scene_name.c_str());
 			if (!scene)
 			{
-				out_jsonReturn = Json(Json::object({{"error", "Did not find an object with name " + scene_name}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + scene_name);
 				return;
 			}
 			else if (!obs_source_is_scene(scene))
 			{
-				out_jsonReturn = Json(Json::object({{"error", "The object found is not a scene"}})).dump();
+				out_jsonReturn = JsonWriter::object(JsonKeys::kError, "The object found is not a scene");
 				return;
 			}
 
@@ -3037,12 +3643,19 @@ void PluginJsHandler::JS_SCENE_GET_SOURCES(const json11::Json &params, std::stri
 				},
 				&source_names);
 
-			out_jsonReturn = Json(Json::object({{"source_names", source_names}})).dump();
-		},
-		Qt::BlockingQueuedConnection);
+			JsonWriter writer(out_jsonReturn);
+			writer.beginObject().key("source_names").beginArray();
+
+			for (const std::string &name : source_names)
+				writer.value(name);
+
+			writer.endArray().endObject();
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_RESTART_OBS(const json11::Json& params, std::string& out_jsonReturn)
+std::string PluginJsHandler::JS_RESTART_OBS()
 {
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
@@ -3053,92 +3666,93 @@ void PluginJsHandler::JS_RESTART_OBS(const json11::Json& params, std::string& ou
 		m_restartArguments = std::make_unique<QStringList>(qApp->arguments());
 		PostMessage(hwnd, WM_CLOSE, 0, 0);
 	}
+
+	return std::string();
 }
 
-void PluginJsHandler::JS_ENUM_SCENES(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_ENUM_SCENES()
 {
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	std::string out_jsonReturn;
 
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[&out_jsonReturn]() {
-			std::vector<json11::Json> sourcesList;
+	ObsReadCache &cache = ObsReadCache::instance();
+	std::string cached;
+	uint64_t generation = 0;
+	const bool hit = cache.lookup(ObsReadCache::SCENES, cached, generation);
 
-			obs_enum_scenes(
-				[](void *param, obs_source_t *source) -> bool {
-					std::vector<json11::Json> *sourcesList = reinterpret_cast<std::vector<json11::Json> *>(param);
+	if (hit && !cache.crossChecking())
+		return cached;
 
-					auto rawName = obs_source_get_name(source);
-					auto rawId = obs_source_get_id(source);
+	// obs_enum_scenes is safe off the Qt thread. Written out as they're enumerated, a large collection is thousands of items
+	JsonWriter writer(out_jsonReturn);
+	writer.beginArray();
 
-					json11::Json sourceInfo = json11::Json::object({
-						{"name", rawName ? rawName : ""},
-						{"type", static_cast<int>(obs_source_get_type(source))},
-						{"id", rawId ? rawId : ""},
-					});
+	obs_enum_scenes(
+		[](void *param, obs_source_t *source) -> bool {
+			JsonWriter *writer = reinterpret_cast<JsonWriter *>(param);
 
-					sourcesList->push_back(sourceInfo);
-					return true; // Continue enumeration
-				},
-				&sourcesList);
+			writer->beginObject()
+				.member("name", obs_source_get_name(source))
+				.member("type", static_cast<int>(obs_source_get_type(source)))
+				.member("id", obs_source_get_id(source))
+				.endObject();
 
-			out_jsonReturn = json11::Json(sourcesList).dump();
+			return true; // Continue enumeration
 		},
-		Qt::BlockingQueuedConnection);
+		&writer);
+
+	writer.endArray();
+
+	if (hit)
+		cache.crossCheck(ObsReadCache::SCENES, generation, cached, out_jsonReturn);
+	else
+		cache.store(ObsReadCache::SCENES, generation, out_jsonReturn);
+
+	return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_QUERY_ALL_SOURCES(const json11::Json &params, std::string &out_jsonReturn)
+JsTask PluginJsHandler::JS_QUERY_ALL_SOURCES()
 {
+	std::string out_jsonReturn;
+
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
 
-	QMetaObject::invokeMethod(
-		mainWindow,
+	co_await onQtThread(mainWindow,
 		[&out_jsonReturn]() {
-			std::vector<json11::Json> sourcesList;
+			// Written out as they're enumerated, a large collection is thousands of items
+			JsonWriter writer(out_jsonReturn);
+			writer.beginArray();
 
 			obs_enum_sources(
 				[](void *param, obs_source_t *source) -> bool {
-					std::vector<json11::Json> *sourcesList = reinterpret_cast<std::vector<json11::Json> *>(param);
-
-					auto rawName = obs_source_get_name(source);
-					auto rawId = obs_source_get_id(source);
+					JsonWriter *writer = reinterpret_cast<JsonWriter *>(param);
 
-					json11::Json sourceInfo = json11::Json::object({
-						{"name", rawName ? rawName : ""},
-						{"type", static_cast<int>(obs_source_get_type(source))},
-						{"id", rawId ? rawId : ""},
-					});
+					writer->beginObject()
+						.member("name", obs_source_get_name(source))
+						.member("type", static_cast<int>(obs_source_get_type(source)))
+						.member("id", obs_source_get_id(source))
+						.endObject();
 
-					sourcesList->push_back(sourceInfo);
 					return true; // Continue enumeration
 				},
-				&sourcesList);
+				&writer);
 
-			out_jsonReturn = json11::Json(sourcesList).dump();
-		},
-		Qt::BlockingQueuedConnection);
+			writer.endArray();
+		});
+
+	co_return out_jsonReturn;
 }
 
-void PluginJsHandler::JS_GET_CANVAS_DIMENSIONS(const json11::Json &params, std::string &out_jsonReturn)
+std::string PluginJsHandler::JS_GET_CANVAS_DIMENSIONS()
 {
-	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	// A copy of the video info, no Qt hop needed. Not cached, a video reset from the settings dialog isn't signalled
+	obs_video_info ovi;
 
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[&out_jsonReturn]() {
-			obs_video_info ovi;
-			if (obs_get_video_info(&ovi))
-			{
-				uint32_t canvas_width = ovi.base_width;
-				uint32_t canvas_height = ovi.base_height;
-				out_jsonReturn = Json(Json::object({{"width", static_cast<int>(canvas_width)}, {"height", static_cast<int>(canvas_height)}})).dump();
-			}
-			else
-			{
-				out_jsonReturn = Json(Json::object({{"error", "Failed to get canvas dimensions"}})).dump();
-			}
-		},
-		Qt::BlockingQueuedConnection);
+	if (!obs_get_video_info(&ovi))
+		return JsonWriter::object(JsonKeys::kError, "Failed to get canvas dimensions");
+
+	std::string out_jsonReturn;
+	JsonWriter(out_jsonReturn).beginObject().member(JsonKeys::kWidth, static_cast<int>(ovi.base_width)).member(JsonKeys::kHeight, static_cast<int>(ovi.base_height)).endObject();
+	return out_jsonReturn;
 }
 
 /***
@@ -3148,7 +3762,18 @@ void PluginJsHandler::JS_GET_CANVAS_DIMENSIONS(const json11::Json &params, std::
 /*static*/
 void PluginJsHandler::handle_obs_frontend_event(obs_frontend_event event, void *data)
 {
+	ObsEventChannel::instance().onFrontendEvent(event);
+	ObsReadCache::instance().onFrontendEvent(event);
 
+	switch (event)
+	{
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		// Every scene was just replaced, versions handed out before this can't be diffed against
+		SceneGraph::instance().resync();
+		break;
+	default:
+		break;
+	}
 }
 
 /***
@@ -3195,50 +3820,49 @@ void PluginJsHandler::onWmClose()
 void PluginJsHandler::saveSlabsBrowserDocks()
 {
 	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	QMetaObject::invokeMethod(mainWindow, [this]() { writeSlabsBrowserDocks(); }, Qt::BlockingQueuedConnection);
+}
 
-	QMetaObject::invokeMethod(
-		mainWindow,
-		[mainWindow, this]() {
-			Json::array jarray;
-			QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
-			QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
-
-			foreach(QDockWidget * dock, docks)
-			{
-				if (dock->property("isSlabs").isValid())
-				{
-					QCefWidgetInternal *widget = (QCefWidgetInternal *)dock->widget();
-
-					std::string url = "http://localhost:0/";
+// Qt thread
+void PluginJsHandler::writeSlabsBrowserDocks()
+{
+	Json::array jarray;
+	QMainWindow *mainWindow = (QMainWindow *)obs_frontend_get_main_window();
+	QList<QDockWidget *> docks = mainWindow->findChildren<QDockWidget *>();
 
-					if (auto browser = widget->cefBrowser)
-					{
-						if (auto mainframe = browser->GetMainFrame())
-							url = mainframe->GetURL();
-						else							
-							blog(LOG_ERROR, "Found null GetMainFrame while saving slabs browser docks");
-					}
-					else
-					{
-						blog(LOG_ERROR, "Found null cefBrowser while saving slabs browser docks");
-					}
+	foreach(QDockWidget * dock, docks)
+	{
+		if (dock->property("isSlabs").isValid())
+		{
+			QCefWidgetInternal *widget = (QCefWidgetInternal *)dock->widget();
 
-					Json::object obj{
-						{"title", dock->windowTitle().toStdString()},
-						{"url", url},
-						{"objectName", dock->objectName().toStdString()},
-					};
+			std::string url = "http://localhost:0/";
 
-					jarray.push_back(obj);
-				}
+			if (auto browser = widget->cefBrowser)
+			{
+				if (auto mainframe = browser->GetMainFrame())
+					url = mainframe->GetURL();
+				else							
+					blog(LOG_ERROR, "Found null GetMainFrame while saving slabs browser docks");
+			}
+			else
+			{
+				blog(LOG_ERROR, "Found null cefBrowser while saving slabs browser docks");
 			}
-			
-			// Json data
-			std::string output = Json(jarray).dump();
-			config_set_string(obs_frontend_get_global_config(), "BasicWindow", "SlabsBrowserDocks", output.c_str());
 
-		},
-		Qt::BlockingQueuedConnection);
+			Json::object obj{
+				{"title", dock->windowTitle().toStdString()},
+				{"url", url},
+				{"objectName", dock->objectName().toStdString()},
+			};
+
+			jarray.push_back(obj);
+		}
+	}
+	
+	// Json data
+	std::string output = Json(jarray).dump();
+	config_set_string(obs_frontend_get_global_config(), "BasicWindow", "SlabsBrowserDocks", output.c_str());
 }
 
 // March 21st, 2024
@@ -3304,7 +3928,7 @@ void PluginJsHandler::loadFonts()
 		{
 			if (itr.path().extension() == ".ttf")
 			{
-				const std::string &filepath = itr.path().generic_u8string();
+				const std::string &filepath = Utf8Path::toString(itr.path().generic_u8string());
 
 				if (WindowsFunctions::InstallFont(filepath.c_str()))
 				{
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <obs.h>
 
@@ -9,13 +15,28 @@
 
 #include <json11/json11.hpp>
 
+#include "JavascriptApi.h"
+#include "JsHandlerBinding.h"
+#include "JsonDocument.h"
+#include "JsTask.h"
+#include "MpscQueue.h"
+#include "sl_browser_api.pb.h"
+
 class PluginJsHandler
 {
 public:
 	void start();
 	void stop();
-	void pushApiRequest(const std::string &funcName, const std::string &params);
-	void executeApiRequest(const std::string &funcName, const std::string &params);
+	// Called on the worker thread with the callback id from 'param1' and the result, the caller decides where the reply goes
+	using ApiCompletion = std::function<void(const int funcId, const std::string &jsonReturn)>;
+
+	void pushApiRequest(const grpc_js_api_Request &request, ApiCompletion onComplete);
+
+	// Anything the browser queued before 'navigation' is dropped, the page it came from is gone
+	//	'closed' drops everything of the browser, its entry is kept for a while for calls still on their way
+	void cancelRequests(const int browserId, const uint32_t navigation, const bool closed);
+	// 'isSuperseded' is for coalesced setters, checked once more on the Qt thread before their work runs
+	void executeApiRequest(const grpc_js_api_Request &request, const ApiCompletion &onComplete, std::function<bool()> isSuperseded = nullptr);
 	void loadSlabsBrowserDocks();
 	void saveSlabsBrowserDocks();
 	void loadFonts();
@@ -34,90 +55,161 @@ private:
 	PluginJsHandler();
 	~PluginJsHandler();
 
-	void workerThread();
+	void workerThread(const JavascriptApi::Lane lane);
+	void loadQueueLimits();
+
+	// Qt thread, saveSlabsBrowserDocks blocks on it from anywhere else
+	void writeSlabsBrowserDocks();
+
+	// Awaitables for JsTask handlers, both come back on a lane worker
+	JsTask::QtHop onQtThread(QObject *target, std::function<void()> func);
+	JsTask::Hop resumeOnLane(const JavascriptApi::Lane lane);
+	void pushResume(std::coroutine_handle<> handle, const JavascriptApi::Lane lane);
+
+	// Arguments already decoded, the public one decodes them first
+	void executeApiRequest(const grpc_js_api_Request &request, JsArgs &args, const int funcId, const ApiCompletion &onComplete, std::function<bool()> isSuperseded);
+
+	// 'args' is param2 onward, a coroutine handler comes back as a task that hasn't started, everything else runs right here, false if apiId is unknown
+	bool dispatch(const JavascriptApi::JSFuncs apiId, JsArgs &args, JsTask &out_task, std::string &out_jsonReturn);
+
+	// Every plugin function's handler, indexed by JSFuncs
+	using TypedHandlers = std::array<JsHandlerBinding::Invoker<PluginJsHandler>, JavascriptApi::JS_FUNC_COUNT>;
+	static const TypedHandlers &typedHandlers();
+
+	// One entry of a batch, [ "jsName", param2, ... ]
+	void runBatchedCall(const JsonNode &call, JsonDocument &resultCheck, std::string &out_results);
 	void freezeCheckThread();
 
-	void JS_QUERY_DOCKS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_EXECUTEJAVASCRIPT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_SETURL(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOWNLOAD_ZIP(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOWNLOAD_FILE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_READ_FILE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DELETE_FILES(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DROP_FOLDER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_QUERY_DOWNLOADS_FOLDER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_SOURCE_CREATE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_SOURCE_DESTROY(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_SETAREA(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_RESIZE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_NEW_BROWSER_DOCK(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_MAIN_WINDOW_GEOMETRY(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_TOGGLE_USER_INPUT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_TOGGLE_DOCK_VISIBILITY(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_SWAP(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DESTROY_DOCK(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_RENAME(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_DOCK_SETTITLE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_STREAMSETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_STREAMSETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SL_VERSION_INFO(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_START_WEBSERVER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_STOP_WEBSERVER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_LAUNCH_OS_BROWSER_URL(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_AUTH_TOKEN(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_CURRENT_SCENE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_CREATE_SCENE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SCENE_ADD(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SOURCE_GET_PROPERTIES(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SOURCE_GET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SOURCE_SET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_INSTALL_FONT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENE_COLLECTIONS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_CURRENT_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_CURRENT_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_ADD_SCENE_COLLECTION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_POS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_ROT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_CROP(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_SCALE_FILTER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_BLENDING_MODE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCENEITEM_BLENDING_METHOD(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SET_SCALE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_POS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_ROT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_CROP(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCALE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_SCALE_FILTER(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_BLENDING_MODE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SCENEITEM_BLENDING_METHOD(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SCENE_GET_SOURCES(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_QUERY_ALL_SOURCES(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_SOURCE_DIMENSIONS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_CANVAS_DIMENSIONS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_CLEAR_AUTH_TOKEN(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_CURRENT_SCENE(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_BRING_FRONT(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_TOGGLE_HIDE_SELF(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_ADD_TRANSITION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_SET_CURRENT_TRANSITION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_OBS_REMOVE_TRANSITION(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_TRANSITION_GET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_TRANSITION_SET_SETTINGS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_ENUM_SCENES(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_RESTART_OBS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_IS_OBS_STREAMING(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_SAVE_SL_BROWSER_DOCKS(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_QT_SET_JS_ON_CLICK_STREAM(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON(const json11::Json &params, std::string &out_jsonReturn);
-	void JS_GET_LOGS_REPORT_STRING(const json11::Json &params, std::string &out_jsonReturn);
+	JsTask JS_BATCH(std::string calls);
+	JsTask JS_QUERY_DOCKS();
+	JsTask JS_DOCK_EXECUTEJAVASCRIPT(std::string objectName, std::string javascriptCode);
+	JsTask JS_DOCK_SETURL(std::string objectName, std::string url);
+	std::string JS_DOWNLOAD_ZIP(std::string url);
+	std::string JS_DOWNLOAD_FILE(std::string url, std::string filename);
+	std::string JS_READ_FILE(std::string filepath);
+	std::string JS_DELETE_FILES(std::string filepaths_jsonStr);
+	std::string JS_DROP_FOLDER(std::string filepath);
+	std::string JS_QUERY_DOWNLOADS_FOLDER();
+	JsTask JS_OBS_SOURCE_CREATE(std::string id, std::string name, std::string settings_jsonStr, std::string hotkey_data_jsonStr, bool raw);
+	JsTask JS_OBS_SOURCE_DESTROY(std::string name);
+	JsTask JS_DOCK_SETAREA(std::string objectName, int areaMask);
+	JsTask JS_DOCK_RESIZE(std::string objectName, int width, int height);
+	JsTask JS_DOCK_NEW_BROWSER_DOCK(std::string title, std::string url, std::string objectName);
+	JsTask JS_GET_MAIN_WINDOW_GEOMETRY();
+	JsTask JS_TOGGLE_USER_INPUT(bool enable);
+	JsTask JS_TOGGLE_DOCK_VISIBILITY(std::string objectName, bool visible);
+	JsTask JS_DOCK_SWAP(std::string objectName1, std::string objectName2);
+	JsTask JS_DESTROY_DOCK(std::string objectName);
+	std::string JS_DOCK_RENAME(std::string objectName, std::string newName);
+	JsTask JS_DOCK_SETTITLE(std::string objectName, std::string newTitle);
+	JsTask JS_SET_STREAMSETTINGS(std::string service, std::string protocol, std::string server, bool use_auth, std::string username, std::string password, std::string key);
+	JsTask JS_GET_STREAMSETTINGS();
+	std::string JS_SL_VERSION_INFO();
+	std::string JS_START_WEBSERVER(int port, std::string expectedReferer, std::string redirectUrl);
+	std::string JS_STOP_WEBSERVER();
+	std::string JS_LAUNCH_OS_BROWSER_URL(std::string url);
+	std::string JS_GET_AUTH_TOKEN();
+	JsTask JS_SET_CURRENT_SCENE(std::string scene_name);
+	JsTask JS_CREATE_SCENE(std::string scene_name);
+	JsTask JS_SCENE_ADD(std::string scene_name, std::string source_name);
+	JsTask JS_SOURCE_GET_PROPERTIES(std::string source_name);
+	std::string JS_SOURCE_GET_SETTINGS(std::string sourceName, bool raw);
+	std::string JS_SOURCE_SET_SETTINGS(std::string sourceName, std::string settingsJson);
+	std::string JS_INSTALL_FONT(std::string filepath);
+	std::string JS_GET_SCENE_COLLECTIONS();
+	std::string JS_GET_CURRENT_SCENE_COLLECTION();
+	std::string JS_SET_CURRENT_SCENE_COLLECTION(std::string name);
+	std::string JS_ADD_SCENE_COLLECTION(std::string name);
+	JsTask JS_SET_SCENEITEM_POS(std::string scene_name, std::string source_name, float x, float y);
+	JsTask JS_SET_SCENEITEM_ROT(std::string scene_name, std::string source_name, float rotation);
+	JsTask JS_SET_SCENEITEM_CROP(std::string scene_name, std::string source_name, int left, int top, int right, int bottom);
+	JsTask JS_SET_SCENEITEM_SCALE_FILTER(std::string scene_name, std::string source_name, int scale_type);
+	JsTask JS_SET_SCENEITEM_BLENDING_MODE(std::string scene_name, std::string source_name, int blending_type);
+	JsTask JS_SET_SCENEITEM_BLENDING_METHOD(std::string scene_name, std::string source_name, int blending_method);
+	JsTask JS_SET_SCENEITEM_TRANSFORMS(std::string transforms);
+	std::string JS_SCENE_GRAPH_SNAPSHOT();
+	std::string JS_SCENE_GRAPH_DIFF(double sinceVersion);
+	std::string JS_OBS_SUBSCRIBE_EVENTS(std::string classes);
+	JsTask JS_SET_SCALE(std::string scene_name, std::string source_name, float x_scale, float y_scale);
+	JsTask JS_GET_SCENEITEM_POS(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCENEITEM_ROT(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCENEITEM_CROP(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCALE(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCENEITEM_SCALE_FILTER(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCENEITEM_BLENDING_MODE(std::string scene_name, std::string source_name);
+	JsTask JS_GET_SCENEITEM_BLENDING_METHOD(std::string scene_name, std::string source_name);
+	JsTask JS_SCENE_GET_SOURCES(std::string scene_name);
+	JsTask JS_QUERY_ALL_SOURCES();
+	std::string JS_GET_SOURCE_DIMENSIONS(std::string source_name);
+	std::string JS_GET_CANVAS_DIMENSIONS();
+	std::string JS_CLEAR_AUTH_TOKEN();
+	JsTask JS_GET_CURRENT_SCENE();
+	std::string JS_OBS_BRING_FRONT();
+	JsTask JS_OBS_TOGGLE_HIDE_SELF(bool boolval);
+	JsTask JS_OBS_ADD_TRANSITION(std::string id, std::string sourceName);
+	JsTask JS_OBS_SET_CURRENT_TRANSITION(std::string sourceName);
+	JsTask JS_OBS_REMOVE_TRANSITION(std::string sourceName);
+	JsTask JS_TRANSITION_GET_SETTINGS(std::string sourceName, bool raw);
+	JsTask JS_TRANSITION_SET_SETTINGS(std::string sourceName, std::string settingsJson);
+	std::string JS_ENUM_SCENES();
+	std::string JS_RESTART_OBS();
+	std::string JS_GET_IS_OBS_STREAMING();
+	JsTask JS_SAVE_SL_BROWSER_DOCKS();
+	std::string JS_QT_SET_JS_ON_CLICK_STREAM(std::string javascriptCode);
+	JsTask JS_QT_INVOKE_CLICK_ON_STREAM_BUTTON();
+	std::string JS_GET_LOGS_REPORT_STRING();
 	
 	std::wstring getDownloadsDir() const;
 	std::wstring getFontsDir() const;
 
-	std::mutex m_queueMtx;
+	struct ApiRequest
+	{
+		grpc_js_api_Request request;
+		ApiCompletion onComplete;
+		// Set when this entry continues a suspended handler instead of starting a call
+		std::coroutine_handle<> resume;
+		// Coalesced setters only, see JavascriptApi::getCoalesceKeyParams
+		std::string coalesceKey;
+		uint64_t coalesceSeq = 0;
+		// Decoded once for the key, dispatch takes them from here
+		JsArgs args;
+		int funcId = 0;
+		bool argsDecoded = false;
+		// Resumed handlers are always taken first
+		JavascriptApi::Priority priority = JavascriptApi::PRIORITY_INTERACTIVE;
+	};
+
+	void runRequest(ApiRequest &request);
+
+	bool isExpired(const ApiRequest &request);
+	bool isSuperseded(const std::string &coalesceKey, const uint64_t coalesceSeq);
+	std::string getCoalesceKey(const JavascriptApi::JSFuncs apiId, const int browserId, const JsArgs &args, const int keyParams);
+
+	// A batch holds the Qt thread for its whole list
+	static constexpr size_t kMaxBatchCalls = 1000;
+
+	// How many calls a lane can have outstanding (queued or waiting on Qt) before one of this priority is refused as busy
+	static constexpr uint64_t kDefaultQueueLimits[JavascriptApi::PRIORITY_COUNT] = {1024, 256, 32};
+	uint64_t m_queueLimits[JavascriptApi::PRIORITY_COUNT] = {kDefaultQueueLimits[0], kDefaultQueueLimits[1], kDefaultQueueLimits[2]};
+	std::atomic<uint64_t> m_laneOutstanding[JavascriptApi::LANE_COUNT] = {};
+	std::atomic<uint64_t> m_busyCount = 0;
+
 	std::atomic<bool> m_running = false;
-	std::vector<std::pair<std::string, std::string>> m_queudRequests;
-	std::thread m_workerThread;
+	// One serial queue and thread per lane, a long download doesn't hold up scene calls
+	MpscQueue<ApiRequest> m_queudRequests[JavascriptApi::LANE_COUNT];
+	std::thread m_workerThreads[JavascriptApi::LANE_COUNT];
+	// Closed browsers are remembered until this many more have closed, cef doesn't reuse browser ids
+	static constexpr size_t kMaxClosedBrowsers = 64;
+
+	// Browser id -> calls with a lower navigation are dropped
+	std::mutex m_cancelMtx;
+	std::map<int, uint32_t> m_cancelledBefore;
+	std::deque<int> m_closedBrowsers;
+	// Coalesced setter target -> sequence of the newest queued call for it
+	std::mutex m_coalesceMtx;
+	std::unordered_map<std::string, uint64_t> m_newestSetters;
+	uint64_t m_coalesceSeq = 0;
+	std::atomic<uint64_t> m_coalescedCount = 0;
 	std::thread m_freezeCheckThread;
 
 	bool m_restartApp = false;
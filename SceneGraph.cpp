@@ -0,0 +1,378 @@
+#include "SceneGraph.h"
+#include "JsonWriter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <obs.hpp>
+
+// Signals on a scene's own handler that change what writeScene reports, groups send the same ones
+static const char *const kSceneSignals[] = {"item_add", "item_remove", "reorder", "refresh", "item_visible", "item_transform"};
+
+/*static*/
+bool SceneGraph::isTracked(obs_source_t *source)
+{
+	return obs_source_is_scene(source) || obs_source_is_group(source);
+}
+
+void SceneGraph::start()
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		m_running = true;
+	}
+
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_connect(handler, "source_create", onSourceCreate, this);
+	signal_handler_connect(handler, "source_destroy", onSourceDestroy, this);
+	signal_handler_connect(handler, "source_rename", onSourceRename, this);
+
+	// Normally none yet, the collection loads after the plugin
+	obs_enum_scenes(
+		[](void *param, obs_source_t *source) -> bool {
+			if (isTracked(source))
+				reinterpret_cast<SceneGraph *>(param)->connectScene(source);
+
+			return true;
+		},
+		this);
+}
+
+void SceneGraph::stop()
+{
+	signal_handler_t *handler = obs_get_signal_handler();
+	signal_handler_disconnect(handler, "source_create", onSourceCreate, this);
+	signal_handler_disconnect(handler, "source_destroy", onSourceDestroy, this);
+	signal_handler_disconnect(handler, "source_rename", onSourceRename, this);
+
+	std::unordered_set<obs_source_t *> scenes;
+
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		m_running = false;
+		scenes.swap(m_connectedScenes);
+	}
+
+	for (obs_source_t *source : scenes)
+	{
+		signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+
+		for (const char *signal : kSceneSignals)
+			signal_handler_disconnect(sceneHandler, signal, onSceneChanged, this);
+	}
+}
+
+void SceneGraph::connectScene(obs_source_t *source)
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (!m_running || !m_connectedScenes.insert(source).second)
+			return;
+	}
+
+	signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+
+	for (const char *signal : kSceneSignals)
+		signal_handler_connect(sceneHandler, signal, onSceneChanged, this);
+
+	const char *name = obs_source_get_name(source);
+
+	if (obs_source_is_group(source))
+		markGroupChanged(name ? name : "");
+	else
+		markChanged(name ? name : "");
+}
+
+void SceneGraph::disconnectScene(obs_source_t *source)
+{
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		if (m_connectedScenes.erase(source) == 0)
+			return;
+	}
+
+	signal_handler_t *sceneHandler = obs_source_get_signal_handler(source);
+
+	for (const char *signal : kSceneSignals)
+		signal_handler_disconnect(sceneHandler, signal, onSceneChanged, this);
+
+	// A group's parent already signalled its item going away
+	if (!obs_source_is_group(source))
+		markRemoved(obs_source_get_name(source) ? obs_source_get_name(source) : "");
+}
+
+void SceneGraph::markChanged(const std::string &sceneName)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	m_changedAt[sceneName] = ++m_version;
+	m_removedAt.erase(sceneName);
+}
+
+void SceneGraph::markRemoved(const std::string &sceneName)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	m_removedAt[sceneName] = ++m_version;
+	m_changedAt.erase(sceneName);
+}
+
+void SceneGraph::markGroupChanged(const std::string &groupName)
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	m_groupChangedAt[groupName] = ++m_version;
+}
+
+void SceneGraph::markAllChanged()
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	const uint64_t version = ++m_version;
+
+	for (obs_source_t *source : m_connectedScenes)
+	{
+		if (obs_source_is_group(source))
+			continue;
+
+		const char *name = obs_source_get_name(source);
+		m_changedAt[name ? name : ""] = version;
+	}
+}
+
+void SceneGraph::resync()
+{
+	std::lock_guard<std::mutex> grd(m_mtx);
+	m_floorVersion = ++m_version;
+	m_changedAt.clear();
+	m_removedAt.clear();
+	m_groupChangedAt.clear();
+}
+
+/*static*/
+void SceneGraph::onSourceCreate(void *data, calldata_t *cd)
+{
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source != nullptr && isTracked(source))
+		static_cast<SceneGraph *>(data)->connectScene(source);
+}
+
+/*static*/
+void SceneGraph::onSourceDestroy(void *data, calldata_t *cd)
+{
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+
+	if (source != nullptr && isTracked(source))
+		static_cast<SceneGraph *>(data)->disconnectScene(source);
+}
+
+/*static*/
+void SceneGraph::onSourceRename(void *data, calldata_t *cd)
+{
+	SceneGraph *self = static_cast<SceneGraph *>(data);
+	obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	const char *newName = calldata_string(cd, "new_name");
+	const char *prevName = calldata_string(cd, "prev_name");
+
+	if (source != nullptr && obs_source_is_scene(source))
+	{
+		self->markRemoved(prevName ? prevName : "");
+		self->markChanged(newName ? newName : "");
+		return;
+	}
+
+	// Items are reported by their source's name, whichever scenes hold it are stale now
+	self->markAllChanged();
+}
+
+/*static*/
+void SceneGraph::onSceneChanged(void *data, calldata_t *cd)
+{
+	SceneGraph *self = static_cast<SceneGraph *>(data);
+	obs_scene_t *scene = static_cast<obs_scene_t *>(calldata_ptr(cd, "scene"));
+	obs_source_t *source = scene ? obs_scene_get_source(scene) : nullptr;
+	const char *name = source ? obs_source_get_name(source) : nullptr;
+
+	if (name == nullptr)
+		return;
+
+	if (obs_source_is_group(source))
+		self->markGroupChanged(name);
+	else
+		self->markChanged(name);
+}
+
+/*static*/
+bool SceneGraph::writeItem(obs_scene_t *, obs_sceneitem_t *item, void *param)
+{
+	JsonWriter &writer = *reinterpret_cast<JsonWriter *>(param);
+
+	vec2 pos, scale, bounds;
+	obs_sceneitem_get_pos(item, &pos);
+	obs_sceneitem_get_scale(item, &scale);
+	obs_sceneitem_get_bounds(item, &bounds);
+
+	obs_sceneitem_crop crop;
+	obs_sceneitem_get_crop(item, &crop);
+
+	// Arrays instead of objects for the numbers, a big collection is thousands of these
+	writer.beginObject()
+		.member("id", int(obs_sceneitem_get_id(item)))
+		.member("source", obs_source_get_name(obs_sceneitem_get_source(item)))
+		.member("visible", obs_sceneitem_visible(item))
+		.member("rot", double(obs_sceneitem_get_rot(item)));
+
+	writer.key("pos").beginArray().value(double(pos.x)).value(double(pos.y)).endArray();
+	writer.key("scale").beginArray().value(double(scale.x)).value(double(scale.y)).endArray();
+	writer.key("crop").beginArray().value(crop.left).value(crop.top).value(crop.right).value(crop.bottom).endArray();
+	writer.key("bounds")
+		.beginArray()
+		.value(int(obs_sceneitem_get_bounds_type(item)))
+		.value(double(bounds.x))
+		.value(double(bounds.y))
+		.value(int(obs_sceneitem_get_bounds_alignment(item)))
+		.endArray();
+
+	writer.member("filter", int(obs_sceneitem_get_scale_filter(item)))
+		.member("blend", int(obs_sceneitem_get_blending_mode(item)))
+		.member("blendMethod", int(obs_sceneitem_get_blending_method(item)));
+
+	// Groups don't nest, this only ever goes one level down
+	if (obs_sceneitem_is_group(item))
+	{
+		writer.key("items").beginArray();
+		obs_sceneitem_group_enum_items(item, writeItem, param);
+		writer.endArray();
+	}
+
+	writer.endObject();
+	return true;
+}
+
+/*static*/
+void SceneGraph::writeScene(JsonWriter &writer, obs_source_t *source)
+{
+	writer.beginObject().member("name", obs_source_get_name(source)).key("items").beginArray();
+
+	// Bottom to top, the order obs draws them in
+	obs_scene_enum_items(obs_scene_from_source(source), writeItem, &writer);
+
+	writer.endArray().endObject();
+}
+
+void SceneGraph::writeSnapshot(JsonWriter &writer)
+{
+	uint64_t version = 0;
+
+	// Read before the scenes are, anything that changes while they're written shows up again in the next diff
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+		version = m_version;
+	}
+
+	writer.beginObject().member("version", double(version)).member("full", true).key("scenes").beginArray();
+
+	obs_enum_scenes(
+		[](void *param, obs_source_t *source) -> bool {
+			if (obs_source_is_scene(source))
+				writeScene(*reinterpret_cast<JsonWriter *>(param), source);
+
+			return true;
+		},
+		&writer);
+
+	writer.endArray().key("removed").beginArray().endArray().endObject();
+}
+
+void SceneGraph::writeDiff(JsonWriter &writer, const uint64_t sinceVersion)
+{
+	uint64_t version = 0;
+	bool full = false;
+	std::vector<std::string> changed;
+	std::vector<std::string> removed;
+	std::vector<std::string> groups;
+
+	{
+		std::lock_guard<std::mutex> grd(m_mtx);
+
+		// From before a resync, or a version this process never handed out (OBS restarted under the page)
+		full = sinceVersion < m_floorVersion || sinceVersion > m_version;
+		version = m_version;
+
+		for (const auto &itr : m_changedAt)
+		{
+			if (itr.second > sinceVersion)
+				changed.push_back(itr.first);
+		}
+
+		for (const auto &itr : m_removedAt)
+		{
+			if (itr.second > sinceVersion)
+				removed.push_back(itr.first);
+		}
+
+		for (const auto &itr : m_groupChangedAt)
+		{
+			if (itr.second > sinceVersion)
+				groups.push_back(itr.first);
+		}
+	}
+
+	if (full)
+	{
+		writeSnapshot(writer);
+		return;
+	}
+
+	// Whichever scenes hold the changed groups now, a group only sits at the top level of a scene
+	if (!groups.empty())
+	{
+		struct ParentLookup
+		{
+			const std::vector<std::string> &groups;
+			std::vector<std::string> &parents;
+		} lookup{groups, changed};
+
+		obs_enum_scenes(
+			[](void *param, obs_source_t *source) -> bool {
+				ParentLookup &lookup = *reinterpret_cast<ParentLookup *>(param);
+
+				if (!obs_source_is_scene(source))
+					return true;
+
+				obs_scene_t *scene = obs_scene_from_source(source);
+
+				for (const std::string &group : lookup.groups)
+				{
+					if (obs_scene_get_group(scene, group.c_str()) != nullptr)
+					{
+						lookup.parents.push_back(obs_source_get_name(source));
+						break;
+					}
+				}
+
+				return true;
+			},
+			&lookup);
+
+		std::sort(changed.begin(), changed.end());
+		changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+	}
+
+	writer.beginObject().member("version", double(version)).member("full", false).key("scenes").beginArray();
+
+	for (const std::string &name : changed)
+	{
+		OBSSourceAutoRelease source = obs_get_source_by_name(name.c_str());
+
+		// Gone again since, the next diff has it as removed
+		if (source && obs_source_is_scene(source))
+			writeScene(writer, source);
+	}
+
+	writer.endArray().key("removed").beginArray();
+
+	for (const std::string &name : removed)
+		writer.value(name);
+
+	writer.endArray().endObject();
+}
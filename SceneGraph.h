@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <obs.h>
+
+class JsonWriter;
+
+/***
+* Versioned model of the scenes and their items, for pages that mirror OBS
+*	libobs scene signals mark a scene changed at the next version, a diff since version N lists only the scenes changed or removed after N
+*	The payload is read from libobs when it's asked for, only names and versions are tracked here
+*	Changes that libobs doesn't signal (scale filter, blending) are marked by the api handlers that make them
+*	A group's items are written inside its item in the parent scene, a change in a group is a change of the scenes holding it
+*/
+
+class SceneGraph
+{
+public:
+	static SceneGraph &instance()
+	{
+		static SceneGraph a;
+		return a;
+	}
+
+	// Before the scene collection loads, scenes are picked up as they're created
+	void start();
+	void stop();
+
+	// { "version": N, "full": true, "scenes": [...], "removed": [] }
+	void writeSnapshot(JsonWriter &writer);
+
+	// Same shape, only the scenes changed after 'sinceVersion', a full snapshot if that's older than what's tracked
+	void writeDiff(JsonWriter &writer, const uint64_t sinceVersion);
+
+	void markChanged(const std::string &sceneName);
+
+	// Everything changed at once (scene collection switch), diffs from before it get a full snapshot
+	void resync();
+
+private:
+	SceneGraph() = default;
+
+	void connectScene(obs_source_t *source);
+	void disconnectScene(obs_source_t *source);
+	void markRemoved(const std::string &sceneName);
+	void markGroupChanged(const std::string &groupName);
+	void markAllChanged();
+
+	static bool isTracked(obs_source_t *source);
+	static void writeScene(JsonWriter &writer, obs_source_t *scene);
+	static bool writeItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+
+	static void onSourceCreate(void *data, calldata_t *cd);
+	static void onSourceDestroy(void *data, calldata_t *cd);
+	static void onSourceRename(void *data, calldata_t *cd);
+	static void onSceneChanged(void *data, calldata_t *cd);
+
+	std::mutex m_mtx;
+	uint64_t m_version = 0;
+	// Diffs from before this can't be answered from what's tracked
+	uint64_t m_floorVersion = 0;
+	std::unordered_map<std::string, uint64_t> m_changedAt;
+	std::unordered_map<std::string, uint64_t> m_removedAt;
+	// Resolved to the scenes holding them when a diff is written, looking them up from the signal would lock scenes on the graphics thread
+	std::unordered_map<std::string, uint64_t> m_groupChangedAt;
+	// Scenes and groups
+	std::unordered_set<obs_source_t *> m_connectedScenes;
+	bool m_running = false;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+/***
+* Shared memory ring for large api results, plugin -> proxy
+*	Single producer (the plugin's reply path, GrpcPlugin serializes its callers), single consumer (the proxy's stream reader thread)
+*	Records are referenced by an absolute offset/length handle sent through grpc, the consumer releases everything up to the end of the record it read
+*	If a handle is lost the space behind it is reclaimed with the next record, if the ring is full the caller sends the payload inline
+*/
+
+class SharedPayloadRing
+{
+public:
+	// Results smaller than this are cheaper to just send in the message
+	static constexpr uint64_t kThreshold = 64 * 1024;
+	static constexpr uint64_t kDefaultCapacity = 32 * 1024 * 1024;
+
+	SharedPayloadRing() = default;
+	~SharedPayloadRing() { close(); }
+
+	SharedPayloadRing(const SharedPayloadRing &) = delete;
+	SharedPayloadRing &operator=(const SharedPayloadRing &) = delete;
+
+	// Plugin
+	bool create(const uint32_t ownerPid, const uint64_t capacity = kDefaultCapacity)
+	{
+		const uint64_t totalSize = sizeof(RingHeader) + capacity;
+		m_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(totalSize >> 32), DWORD(totalSize & 0xFFFFFFFF), getName(ownerPid).c_str());
+
+		if (m_mapping == NULL)
+			return false;
+
+		if (!map())
+			return false;
+
+		m_header = new (m_view) RingHeader{};
+		m_header->capacity = capacity;
+		return true;
+	}
+
+	// Proxy
+	bool open(const uint32_t ownerPid)
+	{
+		m_mapping = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, getName(ownerPid).c_str());
+
+		if (m_mapping == NULL)
+			return false;
+
+		if (!map())
+			return false;
+
+		m_isConsumer = true;
+		m_header = reinterpret_cast<RingHeader *>(m_view);
+		m_header->consumerAttached.store(true, std::memory_order_release);
+		return true;
+	}
+
+	void close()
+	{
+		if (m_header != nullptr && m_isConsumer)
+			m_header->consumerAttached.store(false, std::memory_order_release);
+
+		if (m_view != nullptr)
+			UnmapViewOfFile(m_view);
+
+		if (m_mapping != NULL)
+			CloseHandle(m_mapping);
+
+		m_view = nullptr;
+		m_mapping = NULL;
+		m_header = nullptr;
+	}
+
+	// Producer, false if there's no room or nobody to read it
+	bool write(const std::string &payload, uint64_t &out_offset)
+	{
+		if (m_header == nullptr || !m_header->consumerAttached.load(std::memory_order_acquire))
+			return false;
+
+		const uint64_t capacity = m_header->capacity;
+		const uint64_t head = m_header->head.load(std::memory_order_relaxed);
+		const uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+
+		if (payload.size() > capacity - (head - tail))
+			return false;
+
+		copyIn(head % capacity, payload.data(), payload.size());
+		m_header->head.store(head + payload.size(), std::memory_order_release);
+
+		out_offset = head;
+		return true;
+	}
+
+	// Consumer
+	bool read(const uint64_t offset, const uint64_t length, std::string &out_payload)
+	{
+		if (m_header == nullptr)
+			return false;
+
+		const uint64_t capacity = m_header->capacity;
+		const uint64_t head = m_header->head.load(std::memory_order_acquire);
+		const uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+
+		// Not written yet, or already released
+		if (offset < tail || offset + length > head || length > capacity)
+			return false;
+
+		out_payload.resize(length);
+		copyOut(offset % capacity, out_payload.data(), length);
+
+		m_header->tail.store(offset + length, std::memory_order_release);
+		return true;
+	}
+
+private:
+	struct RingHeader
+	{
+		std::atomic<uint64_t> head{0};
+		std::atomic<uint64_t> tail{0};
+		std::atomic<bool> consumerAttached{false};
+		uint64_t capacity{0};
+	};
+
+	static std::wstring getName(const uint32_t ownerPid) { return L"Local\\sl-browser-payloads-" + std::to_wstring(ownerPid); }
+
+	bool map()
+	{
+		m_view = reinterpret_cast<char *>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+
+		if (m_view == nullptr)
+		{
+			CloseHandle(m_mapping);
+			m_mapping = NULL;
+			return false;
+		}
+
+		return true;
+	}
+
+	char *data() const { return m_view + sizeof(RingHeader); }
+
+	void copyIn(const uint64_t pos, const char *src, const uint64_t length)
+	{
+		const uint64_t firstPart = std::min(length, m_header->capacity - pos);
+		memcpy(data() + pos, src, firstPart);
+		memcpy(data(), src + firstPart, length - firstPart);
+	}
+
+	void copyOut(const uint64_t pos, char *dst, const uint64_t length) const
+	{
+		const uint64_t firstPart = std::min(length, m_header->capacity - pos);
+		memcpy(dst, data() + pos, firstPart);
+		memcpy(dst + firstPart, data(), length - firstPart);
+	}
+
+	HANDLE m_mapping = NULL;
+	char *m_view = nullptr;
+	RingHeader *m_header = nullptr;
+	bool m_isConsumer = false;
+};
@@ -55,29 +55,31 @@ void SlBrowser::run(int argc, char *argv[])
 	}
 
 	m_obs64_PIDt = atoi(argv[1]);
-	int32_t parentListenPort = atoi(argv[2]);
-	int32_t myListenPort = atoi(argv[3]);
+	std::string parentListenAddress = GrpcTransport::fromLaunchArg(argv[2], m_obs64_PIDt, "plugin");
+	std::string myListenAddress = GrpcTransport::fromLaunchArg(argv[3], m_obs64_PIDt, "proxy");
 
-	if (!GrpcBrowser::instance().startServer(myListenPort))
+	// Neither blocks, the link to the plugin is made in the background and announced with com_grpc_ready
+	if (!GrpcBrowser::instance().startServer(myListenAddress))
 	{
 		printf("sl-proxy: failed to start grpc server, GetLastError = %d\n", GetLastError());
 		return;
 	}
 
-	if (!GrpcBrowser::instance().connectToClient(parentListenPort))
+	if (!GrpcBrowser::instance().connectToClient(parentListenAddress))
 	{
 		printf("sl-proxy: failed to connected to plugin's grpc server, GetLastError = %d\n", GetLastError());
 		return;
 	}
+
+	// Optional, large results come inline without it
+	if (!GrpcBrowser::instance().mapPayloadRing(m_obs64_PIDt))
+		printf("sl-proxy: failed to map the shared payload ring, GetLastError = %d\n", GetLastError());
 	
 	QApplication a(argc, argv);
 
-	// Create CEF Browser
+	// Create CEF Browser, initializes alongside the widget below
 	auto manager_thread = thread(&SlBrowser::browserManagerThread, this);
 
-	while (!m_cefInit)
-		::Sleep(1);
-
 	// Create Qt Widget
 	m_widget = new SlBrowserWidget{};
 	m_widget->setWindowTitle("Streamlabs");
@@ -87,6 +89,9 @@ void SlBrowser::run(int argc, char *argv[])
 	// We have to show before creating CEF because it needs the HWND, and the HWND is not made until the QtWidget is shown at least once
 	m_widget->showMinimized();
 
+	while (!m_cefInit)
+		::Sleep(1);
+
 	CefPostTask(TID_UI, base::BindOnce(&CreateCefBrowser, 5));
 
 	std::thread(CheckForObsThread).detach();
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/***
+* Utf8 std::string <-> std::filesystem::path
+*	The plugin builds as C++20 and the proxy as C++17, u8string() is a std::u8string in one and a std::string in the other
+*/
+
+namespace Utf8Path
+{
+	using u8string_t = decltype(std::filesystem::path().u8string());
+
+	static std::string toString(const u8string_t &utf8)
+	{
+		return std::string(reinterpret_cast<const char *>(utf8.data()), utf8.size());
+	}
+
+	// u8path is deprecated from C++20 on
+	static std::filesystem::path toPath(const std::string &utf8)
+	{
+#ifdef __cpp_char8_t
+		return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t *>(utf8.data()), utf8.size()));
+#else
+		return std::filesystem::u8path(utf8);
+#endif
+	}
+}
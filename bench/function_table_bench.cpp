@@ -0,0 +1,101 @@
+#include "JavascriptApi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+/***
+* JavascriptApi's name lookups against the std::map tables they replaced
+*	copied map	what isPluginFunctionName and getFunctionId did, a copy of the map per call and up to two per lookup
+*	map		the same maps by reference, the best the old tables could do
+*	table		the generated perfect hash, one hash and one compare
+*	usage: sl-browser-function-table-bench [rounds]
+*/
+
+// Anything the optimizer can't see through, results are folded into it
+static volatile int g_sink = 0;
+
+static JavascriptApi::JSFuncs copiedMapLookup(const std::string &name)
+{
+	auto plugin = JavascriptApi::getPluginFunctionNames();
+	auto itr = plugin.find(name);
+
+	if (itr != plugin.end())
+		return itr->second;
+
+	auto browser = JavascriptApi::getBrowserFunctionNames();
+	itr = browser.find(name);
+	return itr != browser.end() ? itr->second : JavascriptApi::JS_INVALID;
+}
+
+static JavascriptApi::JSFuncs mapLookup(const std::string &name)
+{
+	const auto &plugin = JavascriptApi::getPluginFunctionNames();
+	auto itr = plugin.find(name);
+
+	if (itr != plugin.end())
+		return itr->second;
+
+	const auto &browser = JavascriptApi::getBrowserFunctionNames();
+	itr = browser.find(name);
+	return itr != browser.end() ? itr->second : JavascriptApi::JS_INVALID;
+}
+
+template<typename Fn> static double measure(const std::vector<std::string> &names, const int rounds, Fn &&fn)
+{
+	int sum = 0;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int r = 0; r < rounds; ++r)
+	{
+		for (const std::string &name : names)
+			sum += int(fn(name));
+	}
+
+	const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	g_sink = g_sink + sum;
+	return ns / (double(rounds) * names.size());
+}
+
+int main(int argc, char **argv)
+{
+	const int rounds = argc > 1 ? std::max(1, atoi(argv[1])) : 20000;
+
+	// Every function, plus names that aren't one, the renderer asks about every property the page touches
+	std::vector<std::string> names;
+
+	for (const auto &itr : JavascriptApi::getPluginFunctionNames())
+		names.push_back(itr.first);
+
+	for (const auto &itr : JavascriptApi::getBrowserFunctionNames())
+		names.push_back(itr.first);
+
+	names.push_back("");
+	names.push_back("toString");
+	names.push_back("obs_sceneitem_set_po");
+	names.push_back("obs_sceneitem_set_posx");
+
+	for (const std::string &name : names)
+	{
+		if (JavascriptApi::getFunctionId(name) != mapLookup(name) || JavascriptApi::isPluginFunctionName(name) != (JavascriptApi::getPluginFunctionNames().count(name) != 0))
+		{
+			printf("The table and the maps disagree on '%s'\n", name.c_str());
+			return 1;
+		}
+	}
+
+	// The copy is slow enough that fewer rounds say the same
+	const double copied = measure(names, std::max(1, rounds / 100), copiedMapLookup);
+	const double map = measure(names, rounds, mapLookup);
+	const double table = measure(names, rounds, [](const std::string &name) { return JavascriptApi::getFunctionId(name); });
+
+	printf("%zu names\n", names.size());
+	printf("copied map %9.1f ns/lookup\n", copied);
+	printf("map        %9.1f ns/lookup\n", map);
+	printf("table      %9.1f ns/lookup   %.0fx the copied map, %.1fx the map\n", table, copied / table, map / table);
+	return 0;
+}
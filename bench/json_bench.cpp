@@ -0,0 +1,333 @@
+#include "JsonDocument.h"
+#include "JsonWriter.h"
+
+#include <json11/json11.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace json11;
+
+/***
+* json11 against JsonDocument and JsonWriter on the payloads in bench/payloads
+*	parse	the whole payload, then every value read once the way a handler would
+*	write	the payload built as a reply, json11 makes a tree and dumps it, JsonWriter writes as it walks
+*	lookup	the per entry member lookups of obs_sceneitems_set_transforms, by name and by interned key
+*	reply	the one member replies most handlers return
+*	usage: sl-browser-json-bench [payload dir] [iterations]
+*/
+
+#ifndef SL_BENCH_PAYLOAD_DIR
+#define SL_BENCH_PAYLOAD_DIR "payloads"
+#endif
+
+// Anything the optimizer can't see through, results are folded into it
+static volatile double g_sink = 0;
+
+template<typename Fn> static double measure(const int iterations, Fn &&fn)
+{
+	// Warm up caches and the arena's first block
+	for (int i = 0; i < iterations / 10 + 1; ++i)
+		fn();
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; ++i)
+		fn();
+
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void report(const char *payload, const char *what, const double json11Us, const double oursUs)
+{
+	printf("%-28s %-8s json11 %9.2f us   ours %9.2f us   %5.1fx\n", payload, what, json11Us, oursUs, json11Us / oursUs);
+}
+
+static double visit(const Json &value)
+{
+	switch (value.type())
+	{
+	case Json::NUMBER: return value.number_value();
+	case Json::BOOL: return value.bool_value();
+	case Json::STRING: return double(value.string_value().size());
+	case Json::ARRAY:
+	{
+		double sum = 0;
+
+		for (const Json &item : value.array_items())
+			sum += visit(item);
+
+		return sum;
+	}
+	case Json::OBJECT:
+	{
+		double sum = 0;
+
+		for (const auto &member : value.object_items())
+			sum += double(member.first.size()) + visit(member.second);
+
+		return sum;
+	}
+	default: return 0;
+	}
+}
+
+static double visit(const JsonNode &value)
+{
+	switch (value.type())
+	{
+	case JsonNode::NUMBER: return value.number_value();
+	case JsonNode::BOOL: return value.bool_value();
+	case JsonNode::STRING: return double(value.string_value().size());
+	case JsonNode::ARRAY:
+	{
+		double sum = 0;
+
+		for (const JsonNode &item : value)
+			sum += visit(item);
+
+		return sum;
+	}
+	case JsonNode::OBJECT:
+	{
+		double sum = 0;
+
+		for (size_t i = 0; i < value.size(); ++i)
+			sum += double(value.members()[i].key.size()) + visit(value.members()[i].value);
+
+		return sum;
+	}
+	default: return 0;
+	}
+}
+
+static void write(JsonWriter &writer, const JsonNode &value)
+{
+	switch (value.type())
+	{
+	case JsonNode::NUMBER: writer.value(value.number_value()); break;
+	case JsonNode::BOOL: writer.value(value.bool_value()); break;
+	case JsonNode::STRING: writer.value(value.string_value()); break;
+	case JsonNode::ARRAY:
+	{
+		writer.beginArray();
+
+		for (const JsonNode &item : value)
+			write(writer, item);
+
+		writer.endArray();
+		break;
+	}
+	case JsonNode::OBJECT:
+	{
+		writer.beginObject();
+
+		for (size_t i = 0; i < value.size(); ++i)
+		{
+			writer.key(value.members()[i].key);
+			write(writer, value.members()[i].value);
+		}
+
+		writer.endObject();
+		break;
+	}
+	default: writer.value(nullptr); break;
+	}
+}
+
+static bool readFile(const std::filesystem::path &path, std::string &out_text)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+		return false;
+
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	out_text = buffer.str();
+	return true;
+}
+
+// Both sides have to agree on what they parsed and wrote before their timings mean anything
+static bool check(const std::string &name, const std::string &text)
+{
+	std::string err;
+	const Json expected = Json::parse(text, err);
+
+	if (!err.empty())
+	{
+		printf("%s: json11 can't parse it, %s\n", name.c_str(), err.c_str());
+		return false;
+	}
+
+	JsonDocument document;
+
+	if (!document.parse(text, err))
+	{
+		printf("%s: JsonDocument can't parse it, %s\n", name.c_str(), err.c_str());
+		return false;
+	}
+
+	std::string written;
+	JsonWriter writer(written);
+	write(writer, document.root());
+
+	if (Json::parse(written, err) != expected || document.root().toJson() != expected)
+	{
+		printf("%s: JsonDocument or JsonWriter differs from json11\n", name.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+static void benchPayload(const std::string &name, const std::string &text, const int iterations)
+{
+	std::string err;
+
+	const double json11Parse = measure(iterations, [&]() { g_sink = g_sink + visit(Json::parse(text, err)); });
+
+	JsonDocument document;
+	const double oursParse = measure(iterations, [&]() {
+		document.parse(text, err);
+		g_sink = g_sink + visit(document.root());
+	});
+
+	report(name.c_str(), "parse", json11Parse, oursParse);
+
+	// Same source for both, the tree json11 needs is part of its cost
+	document.parse(text, err);
+	const JsonNode &root = document.root();
+
+	const double json11Write = measure(iterations, [&]() { g_sink = g_sink + double(root.toJson().dump().size()); });
+
+	std::string written;
+	const double oursWrite = measure(iterations, [&]() {
+		written.clear();
+		JsonWriter writer(written);
+		write(writer, root);
+		g_sink = g_sink + double(written.size());
+	});
+
+	report(name.c_str(), "write", json11Write, oursWrite);
+}
+
+// Members read per entry, same as applySceneItemTransform
+static void benchLookups(const std::string &text, const int iterations)
+{
+	static constexpr JsonKey kScene{"scene"}, kItem{"item"}, kPos{"pos"}, kRot{"rot"}, kScale{"scale"}, kCrop{"crop"}, kBounds{"bounds"}, kFilter{"filter"}, kBlend{"blend"}, kLeft{"left"};
+
+	std::string err;
+	const Json tree = Json::parse(text, err);
+	JsonDocument document;
+	document.parse(text, err);
+
+	const double json11Lookup = measure(iterations, [&]() {
+		double sum = 0;
+
+		for (const Json &entry : tree.array_items())
+		{
+			sum += double(entry["scene"].string_value().size() + entry["item"].string_value().size());
+			sum += entry["pos"]["x"].number_value() + entry["rot"].number_value() + entry["scale"]["y"].number_value();
+			sum += entry["crop"]["left"].number_value() + entry["bounds"]["x"].number_value() + entry["filter"].number_value() + entry["blend"].number_value();
+		}
+
+		g_sink = g_sink + sum;
+	});
+
+	const double namedLookup = measure(iterations, [&]() {
+		double sum = 0;
+
+		for (const JsonNode &entry : document.root())
+		{
+			sum += double(entry["scene"].string_value().size() + entry["item"].string_value().size());
+			sum += entry["pos"]["x"].number_value() + entry["rot"].number_value() + entry["scale"]["y"].number_value();
+			sum += entry["crop"]["left"].number_value() + entry["bounds"]["x"].number_value() + entry["filter"].number_value() + entry["blend"].number_value();
+		}
+
+		g_sink = g_sink + sum;
+	});
+
+	const double internedLookup = measure(iterations, [&]() {
+		double sum = 0;
+
+		for (const JsonNode &entry : document.root())
+		{
+			sum += double(entry[kScene].string_value().size() + entry[kItem].string_value().size());
+			sum += entry[kPos][JsonKeys::kX].number_value() + entry[kRot].number_value() + entry[kScale][JsonKeys::kY].number_value();
+			sum += entry[kCrop][kLeft].number_value() + entry[kBounds][JsonKeys::kX].number_value() + entry[kFilter].number_value() + entry[kBlend].number_value();
+		}
+
+		g_sink = g_sink + sum;
+	});
+
+	report("sceneitem_transforms", "lookup", json11Lookup, namedLookup);
+	report("sceneitem_transforms", "interned", json11Lookup, internedLookup);
+}
+
+static void benchReplies(const int iterations)
+{
+	const std::string sceneName = "Gameplay \xe2\x80\x94 1080p";
+
+	const double json11Error = measure(iterations * 100, [&]() { g_sink = g_sink + double(Json(Json::object{{"error", "Did not find an object with name " + sceneName}}).dump().size()); });
+	const double oursError = measure(iterations * 100, [&]() { g_sink = g_sink + double(JsonWriter::object(JsonKeys::kError, "Did not find an object with name " + sceneName).size()); });
+	report("{\"error\": ...}", "reply", json11Error, oursError);
+
+	const double json11Pos = measure(iterations * 100, [&]() { g_sink = g_sink + double(Json(Json::object({{"x", 758.0625f}, {"y", 52.5f}})).dump().size()); });
+	const double oursPos = measure(iterations * 100, [&]() {
+		std::string reply;
+		JsonWriter(reply).beginObject().member(JsonKeys::kX, 758.0625f).member(JsonKeys::kY, 52.5f).endObject();
+		g_sink = g_sink + double(reply.size());
+	});
+	report("{\"x\": ..., \"y\": ...}", "reply", json11Pos, oursPos);
+}
+
+int main(int argc, char **argv)
+{
+	const std::filesystem::path dir = argc > 1 ? argv[1] : SL_BENCH_PAYLOAD_DIR;
+	const int iterations = argc > 2 ? std::max(1, atoi(argv[2])) : 2000;
+
+	std::vector<std::pair<std::string, std::string>> payloads;
+	std::error_code ec;
+
+	for (const auto &entry : std::filesystem::directory_iterator(dir, ec))
+	{
+		std::string text;
+
+		if (entry.path().extension() == ".json" && readFile(entry.path(), text))
+			payloads.emplace_back(entry.path().stem().string(), std::move(text));
+	}
+
+	if (payloads.empty())
+	{
+		printf("No payloads in %s\n", dir.string().c_str());
+		return 1;
+	}
+
+	std::sort(payloads.begin(), payloads.end());
+
+	for (const auto &payload : payloads)
+	{
+		if (!check(payload.first, payload.second))
+			return 1;
+	}
+
+	for (const auto &payload : payloads)
+	{
+		printf("%s, %zu bytes\n", payload.first.c_str(), payload.second.size());
+		benchPayload(payload.first, payload.second, iterations);
+
+		if (payload.first == "sceneitem_transforms")
+			benchLookups(payload.second, iterations);
+	}
+
+	benchReplies(iterations);
+	return 0;
+}
@@ -1,12 +1,74 @@
 #include "browser-app.hpp"
 #include "browser-version.h"
 #include "JavascriptApi.h"
-
-#include <json11/json11.hpp>
+#include "JsonWriter.h"
 
 #include <windows.h>
 
-using namespace json11;
+class BrowserAppTask : public CefTask
+{
+public:
+	std::function<void()> task;
+	inline BrowserAppTask(std::function<void()> task_) : task(task_) {}
+	void Execute() override { task(); }
+	IMPLEMENT_REFCOUNTING(BrowserAppTask);
+};
+
+// Arrays and plain objects travel as a json string, e.g. the call list for 'batch'
+//	Written as they're walked, a long list used to become a json11 tree first only to be dumped
+static void writeV8Value(JsonWriter &writer, CefRefPtr<CefV8Value> value, const int depth = 0)
+{
+	// Cyclic objects
+	if (depth > 32)
+	{
+		writer.value(nullptr);
+		return;
+	}
+
+	if (value->IsString())
+		writer.value(value->GetStringValue().ToString());
+	else if (value->IsInt())
+		writer.value(value->GetIntValue());
+	else if (value->IsBool())
+		writer.value(value->GetBoolValue());
+	else if (value->IsDouble())
+		writer.value(value->GetDoubleValue());
+	else if (value->IsArray())
+	{
+		writer.beginArray();
+
+		for (int i = 0; i < value->GetArrayLength(); ++i)
+			writeV8Value(writer, value->GetValue(i), depth + 1);
+
+		writer.endArray();
+	}
+	else if (value->IsObject() && !value->IsFunction())
+	{
+		std::vector<CefString> keys;
+		value->GetKeys(keys);
+		writer.beginObject();
+
+		for (auto &key : keys)
+		{
+			writer.key(key.ToString());
+			writeV8Value(writer, value->GetValue(key), depth + 1);
+		}
+
+		writer.endObject();
+	}
+	else
+	{
+		writer.value(nullptr);
+	}
+}
+
+static std::string v8ValueToJson(CefRefPtr<CefV8Value> value)
+{
+	std::string result;
+	JsonWriter writer(result);
+	writeV8Value(writer, value);
+	return result;
+}
 
 CefRefPtr<CefRenderProcessHandler> BrowserApp::GetRenderProcessHandler()
 {
@@ -66,6 +128,62 @@ void BrowserApp::OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFr
 		slabsGlobal->SetValue(itr.first, CefV8Value::CreateFunction(itr.first, this), V8_PROPERTY_ATTRIBUTE_NONE);	
 }
 
+void BrowserApp::OnContextReleased(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, CefRefPtr<CefV8Context> context)
+{
+	std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
+
+	// Nothing left to call them on, the browser process tells the plugin to drop what's still queued
+	for (auto itr = m_callbackMap.begin(); itr != m_callbackMap.end();)
+	{
+		if (itr->second.second->IsSame(context))
+		{
+			m_chunkedResults.erase(itr->first);
+			itr = m_callbackMap.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
+
+	dropEventCallbacks(context);
+}
+
+void BrowserApp::dropEventCallbacks(CefRefPtr<CefV8Context> context)
+{
+	std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
+
+	for (auto itr = m_eventCallbackMap.begin(); itr != m_eventCallbackMap.end();)
+	{
+		if (itr->second.second->IsSame(context))
+			itr = m_eventCallbackMap.erase(itr);
+		else
+			++itr;
+	}
+}
+
+void BrowserApp::expireCallback(const int callbackID)
+{
+	std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
+	auto itr = m_callbackMap.find(callbackID);
+
+	// Answered in time
+	if (itr == m_callbackMap.end())
+		return;
+
+	CefRefPtr<CefV8Value> function = itr->second.first;
+	CefRefPtr<CefV8Context> context = itr->second.second;
+	m_callbackMap.erase(itr);
+	m_chunkedResults.erase(callbackID);
+
+	if (function != nullptr)
+	{
+		CefV8ValueList args;
+		args.push_back(CefV8Value::CreateString(JsonWriter::object(JsonKeys::kError, "Timed out")));
+		function->ExecuteFunctionWithContext(context, nullptr, args);
+	}
+}
+
 bool BrowserApp::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message)
 {
 	if (message->GetName() == "executeCallback")
@@ -88,6 +206,70 @@ bool BrowserApp::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefP
 		}
 	}
 
+	if (message->GetName() == "executeCallbackChunk")
+	{
+		CefRefPtr<CefListValue> arguments = message->GetArgumentList();
+		int callbackID = arguments->GetInt(0);
+		CefRefPtr<CefBinaryValue> data = arguments->GetBinary(1);
+		bool last = arguments->GetBool(2);
+		bool ok = arguments->GetBool(3);
+
+		std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
+		auto callback = m_callbackMap.find(callbackID);
+
+		// Expired or released with its context, nothing would read what's left of it
+		if (callback == m_callbackMap.end())
+		{
+			m_chunkedResults.erase(callbackID);
+			return true;
+		}
+
+		ChunkedResult &result = m_chunkedResults[callbackID];
+
+		// Once a chunk is lost the rest are dropped, the callback gets an error instead
+		result.lost = result.lost || !ok;
+
+		if (!result.lost && data != nullptr && data->GetSize() > 0)
+		{
+			const size_t offset = result.data.size();
+			result.data.resize(offset + data->GetSize());
+			data->GetData(result.data.data() + offset, data->GetSize(), 0);
+		}
+
+		if (last)
+		{
+			std::string jsonString = result.lost ? JsonWriter::object(JsonKeys::kError, "Result was lost") : std::move(result.data);
+			m_chunkedResults.erase(callbackID);
+
+			if (CefRefPtr<CefV8Value> function = callback->second.first)
+			{
+				CefV8ValueList args;
+				args.push_back(CefV8Value::CreateString(jsonString));
+				function->ExecuteFunctionWithContext(callback->second.second, nullptr, args);
+			}
+
+			m_callbackMap.erase(callback);
+		}
+	}
+
+	if (message->GetName() == "executeEventCallback")
+	{
+		CefRefPtr<CefListValue> arguments = message->GetArgumentList();
+		int callbackID = arguments->GetInt(0);
+		CefString jsonString = arguments->GetString(1);
+
+		std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
+		auto itr = m_eventCallbackMap.find(callbackID);
+
+		// Kept, the next frame goes to the same callback
+		if (itr != m_eventCallbackMap.end())
+		{
+			CefV8ValueList args;
+			args.push_back(CefV8Value::CreateString(jsonString));
+			itr->second.first->ExecuteFunctionWithContext(itr->second.second, nullptr, args);
+		}
+	}
+
 	if (message->GetName() == "executeJavascript")
 	{
 		CefRefPtr<CefListValue> arguments = message->GetArgumentList();
@@ -108,6 +290,20 @@ bool BrowserApp::Execute(const CefString &name, CefRefPtr<CefV8Value>, const Cef
 			std::lock_guard<std::recursive_mutex> grd(m_callbackMutex);
 			callBackId = ++m_callbackIdCounter;
 			m_callbackMap[callBackId] = {arguments[0], CefV8Context::GetCurrentContext()};
+
+			// Subscribing again replaces the page's last subscription, in the plugin as well
+			if (JavascriptApi::getFunctionId(name.ToString()) == JavascriptApi::JS_OBS_SUBSCRIBE_EVENTS)
+			{
+				dropEventCallbacks(CefV8Context::GetCurrentContext());
+				m_eventCallbackMap[callBackId] = {arguments[0], CefV8Context::GetCurrentContext()};
+			}
+
+			// Late answers find nothing to call and are dropped
+			if (const int timeoutMs = JavascriptApi::getTimeoutMs(JavascriptApi::getFunctionId(name.ToString())))
+			{
+				CefRefPtr<BrowserApp> self = this;
+				CefPostDelayedTask(TID_RENDERER, CefRefPtr<BrowserAppTask>(new BrowserAppTask([self, callBackId]() { self->expireCallback(callBackId); })), timeoutMs);
+			}
 		}
 
 		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create(name);
@@ -131,6 +327,8 @@ bool BrowserApp::Execute(const CefString &name, CefRefPtr<CefV8Value>, const Cef
 				args->SetBool(pos, arguments[l]->GetBoolValue());
 			else if (arguments[l]->IsDouble())
 				args->SetDouble(pos, arguments[l]->GetDoubleValue());
+			else if (arguments[l]->IsArray() || (arguments[l]->IsObject() && !arguments[l]->IsFunction()))
+				args->SetString(pos, v8ValueToJson(arguments[l]));
 		}
 
 		CefRefPtr<CefBrowser> browser = CefV8Context::GetCurrentContext()->GetBrowser();
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <functional>
 #include <mutex>
+#include <string>
 
 #include "cef-headers.hpp"
 
@@ -16,6 +17,22 @@ class BrowserApp : public CefApp, public CefRenderProcessHandler, public CefBrow
 	std::map<int, std::pair<CefRefPtr<CefV8Value>, CefRefPtr<CefV8Context>>> m_callbackMap;
 	std::recursive_mutex m_callbackMutex;
 
+	// Chunked results being put back together, by callback id
+	struct ChunkedResult
+	{
+		std::string data;
+		bool lost = false;
+	};
+
+	std::map<int, ChunkedResult> m_chunkedResults;
+
+	// obs_subscribe_events callbacks, called for every event frame instead of once, one per context
+	std::map<int, std::pair<CefRefPtr<CefV8Value>, CefRefPtr<CefV8Context>>> m_eventCallbackMap;
+
+	// Renderer thread, answers the callback with an error if nothing came back in time
+	void expireCallback(const int callbackID);
+	void dropEventCallbacks(CefRefPtr<CefV8Context> context);
+
 public:
 	inline BrowserApp() {}
 
@@ -25,6 +42,7 @@ public:
 	virtual void OnRegisterCustomSchemes(CefRawPtr<CefSchemeRegistrar> registrar) override;
 	virtual void OnBeforeCommandLineProcessing(const CefString &process_type, CefRefPtr<CefCommandLine> command_line) override;
 	virtual void OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
+	virtual void OnContextReleased(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
 	virtual bool OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message) override;
 	virtual bool Execute(const CefString &name, CefRefPtr<CefV8Value> object, const CefV8ValueList &arguments, CefRefPtr<CefV8Value> &retval, CefString &exception) override;
 
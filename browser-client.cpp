@@ -1,19 +1,16 @@
 #include "browser-client.hpp"
 #include "base64/base64.hpp"
-#include "json11/json11.hpp"
 
 #include <QApplication>
 #include <QThread>
 #include <QToolTip>
 #include "GrpcBrowser.h"
 #include "JavascriptApi.h"
+#include "JavascriptApiArgs.h"
+#include "JsonWriter.h"
 #include "SlBrowser.h"
 #include "WindowsFunctions.h"
 
-#include <json11/json11.hpp>
-
-using namespace json11;
-
 inline bool BrowserClient::valid() const
 {
 	return true;
@@ -77,73 +74,91 @@ bool BrowserClient::OnBeforePopup(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, co
 	return true;
 }
 
+void BrowserClient::OnBeforeClose(CefRefPtr<CefBrowser> browser)
+{
+	std::lock_guard<std::recursive_mutex> grd(m_recursiveMutex);
+	GrpcBrowser::instance().getClient()->send_js_cancel(browser->GetIdentifier(), m_navigations[browser->GetIdentifier()] + 1, true);
+
+	m_knownBrowsers.erase(browser->GetIdentifier());
+	m_navigations.erase(browser->GetIdentifier());
+
+	if (m_MostRecentRenderKnowOf != nullptr && m_MostRecentRenderKnowOf->IsSame(browser))
+		m_MostRecentRenderKnowOf = nullptr;
+}
+
 void BrowserClient::OnBeforeContextMenu(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, CefRefPtr<CefContextMenuParams>, CefRefPtr<CefMenuModel> model)
 {
 	/* remove all context menu contributions */
 	model->Clear();
 }
 
-/*static*/
-json11::Json convertCefValueToJSON(CefRefPtr<CefValue> value)
+// Straight into the output, no json11 tree in between just to dump it
+static void writeCefValue(JsonWriter &writer, CefRefPtr<CefValue> value)
 {
 	switch (value->GetType())
 	{
-	case VTYPE_NULL:
-		return nullptr;
-
 	case VTYPE_BOOL:
-		return value->GetBool();
+		writer.value(value->GetBool());
+		break;
 
 	case VTYPE_INT:
-		return value->GetInt();
+		writer.value(value->GetInt());
+		break;
 
 	case VTYPE_DOUBLE:
-		return value->GetDouble();
+		writer.value(value->GetDouble());
+		break;
 
 	case VTYPE_STRING:
-		return value->GetString().ToString();
+		writer.value(value->GetString().ToString());
+		break;
 
 	case VTYPE_LIST: {
 		const auto &list = value->GetList();
-		std::vector<json11::Json> jsonList;
+		writer.beginArray();
+
 		for (size_t i = 0; i < list->GetSize(); ++i)
-		{
-			jsonList.push_back(convertCefValueToJSON(list->GetValue(i)));
-		}
-		return jsonList;
+			writeCefValue(writer, list->GetValue(i));
+
+		writer.endArray();
+		break;
 	}
 
 	case VTYPE_DICTIONARY: {
 		const auto &dict = value->GetDictionary();
-		std::map<std::string, json11::Json> jsonMap;
 		CefDictionaryValue::KeyList keys;
 		dict->GetKeys(keys);
+		writer.beginObject();
+
 		for (const auto &key : keys)
 		{
-			jsonMap[key] = convertCefValueToJSON(dict->GetValue(key));
+			writer.key(key.ToString());
+			writeCefValue(writer, dict->GetValue(key));
 		}
-		return jsonMap;
+
+		writer.endObject();
+		break;
 	}
 
 	default:
-		return nullptr;
+		writer.value(nullptr);
+		break;
 	}
 }
 
 /*static*/
 std::string BrowserClient::cefListValueToJSONString(CefRefPtr<CefListValue> listValue)
 {
-	std::map<std::string, json11::Json> jsonMap;
+	// Positional, [param1, param2, ...] the same order the typed handlers bind in
+	std::string result;
+	JsonWriter writer(result);
+	writer.beginArray();
+
 	for (size_t i = 0; i < listValue->GetSize(); ++i)
-	{
-		// Convert index to string key like "param1", "param2", ...
-		std::string key = "param" + std::to_string(i + 1);
-		jsonMap[key] = convertCefValueToJSON(listValue->GetValue(i));
-	}
+		writeCefValue(writer, listValue->GetValue(i));
 
-	std::string json_str;
-	json_str = json11::Json(jsonMap).dump();
-	return json_str;
+	writer.endArray();
+	return result;
 }
 
 CefRefPtr<CefBrowser> BrowserClient::GetMostRecentRenderKnown()
@@ -152,25 +167,27 @@ CefRefPtr<CefBrowser> BrowserClient::GetMostRecentRenderKnown()
 	return m_MostRecentRenderKnowOf;
 }
 
-void BrowserClient::RegisterCallback(const int functionId, CefRefPtr<CefBrowser> browser)
+void BrowserClient::RegisterBrowser(CefRefPtr<CefBrowser> browser)
 {
 	std::lock_guard<std::recursive_mutex> grd(m_recursiveMutex);
-	m_callbackDictionary[functionId] = browser;
+	m_knownBrowsers[browser->GetIdentifier()] = browser;
 	m_MostRecentRenderKnowOf = browser;
 }
 
-CefRefPtr<CefBrowser> BrowserClient::PopCallback(const int functionId)
+uint32_t BrowserClient::GetNavigation(const int browserId)
 {
 	std::lock_guard<std::recursive_mutex> grd(m_recursiveMutex);
+	return m_navigations[browserId];
+}
 
-	auto itr = m_callbackDictionary.find(functionId);
+CefRefPtr<CefBrowser> BrowserClient::GetKnownBrowser(const int browserId)
+{
+	std::lock_guard<std::recursive_mutex> grd(m_recursiveMutex);
 
-	if (itr != m_callbackDictionary.end())
-	{
-		CefRefPtr<CefBrowser> browser = itr->second;
-		m_callbackDictionary.erase(itr);
-		return browser;
-	}
+	auto itr = m_knownBrowsers.find(browserId);
+
+	if (itr != m_knownBrowsers.end())
+		return itr->second;
 
 	return nullptr;
 }
@@ -202,7 +219,7 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 		{
 			if (argsWithoutFunc.size() < 2)
 			{
-				jsonOutput = Json(Json::object({{"error", "Invalid parameters"}})).dump();
+				jsonOutput = JsonWriter::object(JsonKeys::kError, "Invalid parameters");
 				break;
 			}
 
@@ -211,7 +228,7 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 
 			if (w < 200 || h < 200 || w > 8096 || h > 8096)
 			{
-				jsonOutput = Json(Json::object({{"error", "Invalid parameters"}})).dump();
+				jsonOutput = JsonWriter::object(JsonKeys::kError, "Invalid parameters");
 				break;
 			}
 
@@ -232,7 +249,7 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 		{
 			if (argsWithoutFunc.size() < 2)
 			{
-				jsonOutput = Json(Json::object({{"error", "Invalid parameters"}})).dump();
+				jsonOutput = JsonWriter::object(JsonKeys::kError, "Invalid parameters");
 				break;
 			}
 
@@ -246,7 +263,7 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 		{
 			if (argsWithoutFunc.size() < 1)
 			{
-				jsonOutput = Json(Json::object({{"error", "Invalid parameters"}})).dump();
+				jsonOutput = JsonWriter::object(JsonKeys::kError, "Invalid parameters");
 				break;
 			}
 
@@ -257,7 +274,7 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 		{
 			if (argsWithoutFunc.size() < 1)
 			{
-				jsonOutput = Json(Json::object({{"error", "Invalid parameters"}})).dump();
+				jsonOutput = JsonWriter::object(JsonKeys::kError, "Invalid parameters");
 				break;
 			}
 
@@ -283,13 +300,39 @@ bool BrowserClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefR
 	}
 	else
 	{
-		RegisterCallback(funcid, browser);
+		// Replies are routed back by browser id, the renderer matches them to the call by funcid
+		RegisterBrowser(browser);
 
-		if (!GrpcBrowser::instance().getClient()->send_js_api(name, cefListValueToJSONString(input_args)))
+		grpc_js_api_Request request;
+		request.set_funcname(name);
+		request.set_funcid(funcid);
+		request.set_browserid(browser->GetIdentifier());
+		request.set_navigation(GetNavigation(browser->GetIdentifier()));
+
+		// Same table the renderer times its callback out with, the plugin skips the call once the page stopped waiting
+		if (const int timeoutMs = JavascriptApi::getTimeoutMs(JavascriptApi::getFunctionId(name)))
 		{
-			// todo; handle
-			abort();
-			return false;
+			using namespace std::chrono;
+			request.set_deadline(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + timeoutMs);
+		}
+
+		// Known functions go typed, anything else as json and the plugin reports it
+		const JavascriptApi::JSFuncs apiId = JavascriptApi::getFunctionId(name);
+
+		if (JavascriptApiArgs::encode(apiId, input_args.get(), *request.mutable_args()))
+			request.set_apiid(apiId);
+		else
+			request.set_params(cefListValueToJSONString(input_args));
+
+		// Only fails once the link has been down long enough to fill the queue, tell the page instead of waiting forever
+		if (!GrpcBrowser::instance().getClient()->send_js_api(request))
+		{
+			CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("executeCallback");
+			CefRefPtr<CefListValue> execute_args = msg->GetArgumentList();
+			execute_args->SetInt(0, funcid);
+			execute_args->SetString(1, JsonWriter::object(JsonKeys::kError, "Plugin is not reachable"));
+
+			SendBrowserProcessMessage(browser, PID_RENDERER, msg);
 		}
 	}
 
@@ -384,6 +427,13 @@ bool BrowserClient::GetAudioParameters(CefRefPtr<CefBrowser> browser, CefAudioPa
 void BrowserClient::OnLoadStart(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, TransitionType transition_type)
 {
 	SlBrowser::instance().setMainLoadingInProgress(true);
+
+	// Callbacks of the previous page are gone with it. Its calls carry the old navigation, the cancel doesn't have to beat the new page's calls
+	if (frame->IsMain())
+	{
+		std::lock_guard<std::recursive_mutex> grd(m_recursiveMutex);
+		GrpcBrowser::instance().getClient()->send_js_cancel(browser->GetIdentifier(), ++m_navigations[browser->GetIdentifier()], false);
+	}
 }
 
 void BrowserClient::OnLoadEnd(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame> frame, int httpStatusCode)
@@ -29,6 +29,7 @@ public:
 	/* CefLifeSpanHandler */
 	bool OnBeforePopup(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, const CefString &target_url, const CefString &target_frame_name, cef_window_open_disposition_t target_disposition, bool user_gesture, const CefPopupFeatures &popupFeatures, CefWindowInfo &windowInfo,
 			   CefRefPtr<CefClient> &client, CefBrowserSettings &settings, CefRefPtr<CefDictionaryValue> &extra_info, bool *no_javascript_access) override;
+	void OnBeforeClose(CefRefPtr<CefBrowser> browser) override;
 
 	bool OnTooltip(CefRefPtr<CefBrowser> browser, CefString &text) override;
 	bool OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message) override;
@@ -69,8 +70,9 @@ public:
 
 public:
 	CefRefPtr<CefBrowser> GetMostRecentRenderKnown();
-	CefRefPtr<CefBrowser> PopCallback(const int functionId);
-	void RegisterCallback(const int functionId, CefRefPtr<CefBrowser> browser);
+	CefRefPtr<CefBrowser> GetKnownBrowser(const int browserId);
+	void RegisterBrowser(CefRefPtr<CefBrowser> browser);
+	uint32_t GetNavigation(const int browserId);
 
 public:
 	static std::string cefListValueToJSONString(CefRefPtr<CefListValue> listValue);
@@ -82,7 +84,9 @@ private:
 	bool m_reroute_audio = true;
 
 	std::recursive_mutex m_recursiveMutex;
-	std::map<int, CefRefPtr<CefBrowser>> m_callbackDictionary;
+	std::map<int, CefRefPtr<CefBrowser>> m_knownBrowsers;
+	// Main frame loads per browser, stamped on every api call so the plugin can tell pages apart
+	std::map<int, uint32_t> m_navigations;
 
 	CefRefPtr<CefBrowser> m_Browser;
 	CefRefPtr<CefBrowser> m_MostRecentRenderKnowOf = nullptr;
@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+#
+# Generates the javascript api sources from sl_browser_api.idl
+#	usage: generate_js_api.py <sl_browser_api.idl> <output dir>
+#
+#	JavascriptApiFuncs.gen.h		X-macro tables of every function, used by JavascriptApi.h
+#	sl_browser_api_args.proto		one typed argument message per plugin function
+#	JavascriptApiArgsEncode.gen.cpp		proxy, CefListValue -> argument message
+#	JavascriptApiArgsDecode.gen.cpp		plugin, argument message -> positional arguments for the JS_* handlers
+
+import os
+import re
+import sys
+
+TYPES = {
+	# idl: (proto type, encoder getter, decoder statement)
+	'string': ('string', 'argString', 'out_args.addString(std::move(*msg.mutable_%s()));'),
+	'int': ('int32', 'argInt', 'out_args.addNumber(msg.%s());'),
+	'double': ('double', 'argDouble', 'out_args.addNumber(msg.%s());'),
+	'bool': ('bool', 'argBool', 'out_args.addBool(msg.%s());'),
+}
+
+# JsArgs::kMaxArgs
+MAX_PARAMS = 8
+
+BANNER = 'Generated from sl_browser_api.idl by cmake/generate_js_api.py, do not edit'
+
+
+class Function:
+	def __init__(self, side, js_name, enum, params, lane, priority, timeout, line):
+		self.side = side
+		self.js_name = js_name
+		self.enum = enum
+		self.params = params
+		self.lane = lane
+		self.priority = priority
+		self.timeout = timeout
+		self.line = line
+
+	@property
+	def message(self):
+		return self.enum + '_Args'
+
+
+def snake_case(name):
+	name = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', name)
+	return name.lower()
+
+
+def parse(path):
+	functions = []
+	entry = re.compile(r'^(plugin|browser)\s+(\w+)\s+(JS_\w+)\s*\((.*)\)\s*(?:lane\s+(ui|obs|io))?\s*(?:priority\s+(interactive|normal|bulk))?\s*(?:timeout\s+(\d+|none))?\s*$')
+
+	with open(path, 'r', encoding='utf-8') as f:
+		for number, raw in enumerate(f, 1):
+			line = raw.strip()
+
+			if not line or line.startswith('//') or line.startswith('section '):
+				continue
+
+			match = entry.match(line)
+
+			if not match:
+				sys.exit('%s(%d): cannot parse "%s"' % (path, number, line))
+
+			side, js_name, enum, param_list, lane, priority, timeout = match.groups()
+			params = []
+
+			for param in filter(None, (p.strip() for p in param_list.split(','))):
+				parts = param.split()
+
+				if len(parts) != 2 or parts[0] not in TYPES:
+					sys.exit('%s(%d): bad parameter "%s"' % (path, number, param))
+
+				params.append((parts[0], snake_case(parts[1])))
+
+			if len(params) > MAX_PARAMS:
+				sys.exit('%s(%d): more than %d parameters' % (path, number, MAX_PARAMS))
+
+			# 0 is the default, -1 no deadline
+			timeout = -1 if timeout == 'none' else int(timeout or 0)
+
+			functions.append(Function(side, js_name, enum, params, 'LANE_' + (lane or 'ui').upper(), 'PRIORITY_' + (priority or 'normal').upper(), timeout, number))
+
+	seen = set()
+
+	for func in functions:
+		for key in (func.js_name, func.enum):
+			if key in seen:
+				sys.exit('%s(%d): "%s" is declared twice' % (path, func.line, key))
+
+			seen.add(key)
+
+	return functions
+
+
+def write(path, text):
+	with open(path, 'w', encoding='utf-8', newline='\n') as f:
+		f.write(text)
+
+
+def name_slot(name, seed, bits):
+	# 32 bit FNV-1a with the seed as offset basis, the top bits after a Fibonacci multiply are the slot
+	#	JavascriptApi::nameSlot has to match
+	value = seed
+
+	for byte in name.encode('utf-8'):
+		value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+
+	return ((value * 2654435769) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def perfect_hash(functions):
+	# Power of two at least four times the function count, then the first seed that puts every name in its own slot
+	bits = 1
+
+	while (1 << bits) < len(functions) * 4:
+		bits += 1
+
+	for seed in range(2166136261, 2166136261 + 1000000):
+		slots = {}
+
+		for func in functions:
+			slot = name_slot(func.js_name, seed, bits)
+
+			if slot in slots:
+				break
+
+			slots[slot] = func
+		else:
+			return seed, bits, slots
+
+	sys.exit('no perfect hash seed found, raise the table size')
+
+
+def gen_funcs_header(functions):
+	out = ['// ' + BANNER, '', '#pragma once', '']
+
+	for side, macro in (('plugin', 'SL_JS_PLUGIN_FUNCS'), ('browser', 'SL_JS_BROWSER_FUNCS')):
+		out.append('// X(jsName, JS_ENUM, timeoutMs, lane, priority), timeoutMs 0 is the default and -1 no deadline')
+		out.append('#define %s(X) \\' % macro)
+
+		for func in (f for f in functions if f.side == side):
+			out.append('\tX(%s, %s, %d, %s, %s) \\' % (func.js_name, func.enum, func.timeout, func.lane, func.priority))
+
+		out.append('')
+		out.append('')
+
+	seed, bits, slots = perfect_hash(functions)
+
+	out.append('// Perfect hash of every jsName, no two share a slot')
+	out.append('#define SL_JS_NAME_HASH_SEED %du' % seed)
+	out.append('#define SL_JS_NAME_HASH_BITS %d' % bits)
+	out.append('')
+	out.append('// X(slot, jsName, JS_ENUM, isPlugin)')
+	out.append('#define SL_JS_NAME_HASH_SLOTS(X) \\')
+
+	for slot in sorted(slots):
+		func = slots[slot]
+		out.append('\tX(%d, %s, %s, %s) \\' % (slot, func.js_name, func.enum, 'true' if func.side == 'plugin' else 'false'))
+
+	out.append('')
+	out.append('')
+
+	return '\n'.join(out)
+
+
+def gen_args_proto(functions):
+	out = ['// ' + BANNER, '', 'syntax = "proto3";', '', 'option cc_enable_arenas = true;', '']
+
+	for func in (f for f in functions if f.side == 'plugin'):
+		out.append('// %s' % func.js_name)
+		out.append('message %s {' % func.message)
+
+		# Field numbers are the param position, param1 is the callback and travels in the request
+		for position, (kind, name) in enumerate(func.params, 2):
+			out.append('\t%s %s = %d;' % (TYPES[kind][0], name, position))
+
+		out.append('}')
+		out.append('')
+
+	return '\n'.join(out)
+
+
+def gen_encode(functions):
+	out = ['// ' + BANNER, '',
+		'#include "JavascriptApiArgs.h"',
+		'#include "JavascriptApi.h"',
+		'#include "cef-headers.hpp"',
+		'#include "sl_browser_api_args.pb.h"',
+		'',
+		'// Same coercion as json11\'s string_value/int_value/number_value/bool_value, so handlers see what they used to',
+		'static std::string argString(CefListValue *list, size_t index)',
+		'{',
+		'\treturn index < list->GetSize() && list->GetType(index) == VTYPE_STRING ? list->GetString(index).ToString() : std::string();',
+		'}',
+		'',
+		'static double argDouble(CefListValue *list, size_t index)',
+		'{',
+		'\tif (index >= list->GetSize())',
+		'\t\treturn 0;',
+		'',
+		'\tswitch (list->GetType(index))',
+		'\t{',
+		'\tcase VTYPE_INT: return list->GetInt(index);',
+		'\tcase VTYPE_DOUBLE: return list->GetDouble(index);',
+		'\tdefault: return 0;',
+		'\t}',
+		'}',
+		'',
+		'static int argInt(CefListValue *list, size_t index)',
+		'{',
+		'\treturn static_cast<int>(argDouble(list, index));',
+		'}',
+		'',
+		'static bool argBool(CefListValue *list, size_t index)',
+		'{',
+		'\treturn index < list->GetSize() && list->GetType(index) == VTYPE_BOOL && list->GetBool(index);',
+		'}',
+		'',
+		'bool JavascriptApiArgs::encode(const int apiId, CefListValue *list, std::string &out_args)',
+		'{',
+		'\tswitch (apiId)',
+		'\t{']
+
+	for func in (f for f in functions if f.side == 'plugin'):
+		out.append('\tcase JavascriptApi::%s:' % func.enum)
+		out.append('\t{')
+		out.append('\t\t%s args;' % func.message)
+
+		# List index 0 is param1
+		for position, (kind, name) in enumerate(func.params, 2):
+			out.append('\t\targs.set_%s(%s(list, %d));' % (name, TYPES[kind][1], position - 1))
+
+		out.append('\t\treturn args.SerializeToString(&out_args);')
+		out.append('\t}')
+
+	out += ['\tdefault: return false;', '\t}', '}', '']
+	return '\n'.join(out)
+
+
+def gen_decode(functions):
+	out = ['// ' + BANNER, '',
+		'#include "JavascriptApiArgs.h"',
+		'#include "JavascriptApi.h"',
+		'#include "sl_browser_api_args.pb.h"',
+		'',
+		'bool JavascriptApiArgs::decode(const int apiId, const std::string &args, JsArgs &out_args)',
+		'{',
+		'\tswitch (apiId)',
+		'\t{']
+
+	for func in (f for f in functions if f.side == 'plugin'):
+		out.append('\tcase JavascriptApi::%s:' % func.enum)
+		out.append('\t{')
+		out.append('\t\t%s msg;' % func.message)
+		out.append('')
+		out.append('\t\tif (!msg.ParseFromString(args))')
+		out.append('\t\t\treturn false;')
+
+		if func.params:
+			out.append('')
+
+		# Index 0 is param2, strings are moved out of the message instead of copied
+		for kind, name in func.params:
+			out.append('\t\t' + TYPES[kind][2] % name)
+
+		out.append('\t\treturn true;')
+		out.append('\t}')
+
+	out += ['\tdefault: return false;', '\t}', '}', '']
+	return '\n'.join(out)
+
+
+def main():
+	if len(sys.argv) != 3:
+		sys.exit('usage: generate_js_api.py <sl_browser_api.idl> <output dir>')
+
+	functions = parse(sys.argv[1])
+	out_dir = sys.argv[2]
+
+	os.makedirs(out_dir, exist_ok=True)
+	write(os.path.join(out_dir, 'JavascriptApiFuncs.gen.h'), gen_funcs_header(functions))
+	write(os.path.join(out_dir, 'sl_browser_api_args.proto'), gen_args_proto(functions))
+	write(os.path.join(out_dir, 'JavascriptApiArgsEncode.gen.cpp'), gen_encode(functions))
+	write(os.path.join(out_dir, 'JavascriptApiArgsDecode.gen.cpp'), gen_decode(functions))
+
+
+if __name__ == '__main__':
+	main()
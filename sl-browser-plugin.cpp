@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <string>
 #include <filesystem>
+#include <thread>
 
 #include "GrpcPlugin.h"
 #include "PluginJsHandler.h"
@@ -15,6 +16,10 @@
 #include "ConsoleToggle.h"
 #include "CrashHandler.h"
 #include "QtGuiModifications.h"
+#include "Utf8Path.h"
+#include "ObsEventChannel.h"
+#include "ObsReadCache.h"
+#include "SceneGraph.h"
 
 #include <QMainWindow>
 #include <QMenuBar>
@@ -24,6 +29,9 @@
 
 PROCESS_INFORMATION g_browserProcessInfo;
 
+// Waits out the proxy's startup, joined on unload so it never runs after the module is gone
+std::thread g_proxyReadyThread;
+
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE("sl-browser-plugin", "en-US")
 MODULE_EXPORT const char *obs_module_description(void)
@@ -115,6 +123,9 @@ void obs_module_post_load(void)
 	*/
 
 	QtGuiModifications::instance();
+	SceneGraph::instance().start();
+	ObsEventChannel::instance().start();
+	ObsReadCache::instance().start();
 	PluginJsHandler::instance().start();
 
 	obs_frontend_add_event_callback(PluginJsHandler::instance().handle_obs_frontend_event, nullptr);
@@ -147,16 +158,33 @@ void obs_module_post_load(void)
 	};
 
 	bool browserGood = false;
-	int32_t myListenPort = chooseProxyPort();
-	int32_t targetListenPort = chooseProxyPort();
 
-	blog(LOG_INFO, "%s: Sending %d and %d to proxy", obs_module_description(), myListenPort, targetListenPort);
+	// Local sockets first, their paths are derived from our pid on both sides
+	std::string myListenAddress = GrpcTransport::unixAddress(GetCurrentProcessId(), "plugin");
+	std::string targetListenAddress = GrpcTransport::unixAddress(GetCurrentProcessId(), "proxy");
+	std::wstring transportParams = L"unix unix";
+
+	bool serverGood = !myListenAddress.empty() && GrpcPlugin::instance().startServer(myListenAddress);
+
+	if (!serverGood)
+	{
+		int32_t myListenPort = chooseProxyPort();
+		int32_t targetListenPort = chooseProxyPort();
+
+		myListenAddress = GrpcTransport::tcpAddress(myListenPort);
+		targetListenAddress = GrpcTransport::tcpAddress(targetListenPort);
+		transportParams = std::to_wstring(myListenPort) + L" " + std::to_wstring(targetListenPort);
+
+		serverGood = GrpcPlugin::instance().startServer(myListenAddress);
+	}
+
+	blog(LOG_INFO, "%s: Sending %s and %s to proxy", obs_module_description(), myListenAddress.c_str(), targetListenAddress.c_str());
 
 	STARTUPINFOW si;
 	memset(&si, NULL, sizeof(si));
 	si.cb = sizeof(si);
 
-	if (GrpcPlugin::instance().startServer(myListenPort))
+	if (serverGood)
 	{
 		try
 		{
@@ -165,8 +193,8 @@ void obs_module_post_load(void)
 			if (!module_path)
 				return;
 
-			std::wstring process_path = std::filesystem::u8path(module_path).remove_filename().wstring() + L"/sl-browser.exe";
-			std::wstring startparams = L"sl-browser " + std::to_wstring(GetCurrentProcessId()) + L" " + std::to_wstring(myListenPort) + L" " + std::to_wstring(targetListenPort);
+			std::wstring process_path = Utf8Path::toPath(module_path).remove_filename().wstring() + L"/sl-browser.exe";
+			std::wstring startparams = L"sl-browser " + std::to_wstring(GetCurrentProcessId()) + L" " + transportParams;
 			browserGood = CreateProcessW(process_path.c_str(), (LPWSTR)startparams.c_str(), NULL, NULL, FALSE, CREATE_NEW_CONSOLE, NULL, NULL, &si, &g_browserProcessInfo);
 		}
 		catch (...)
@@ -174,16 +202,9 @@ void obs_module_post_load(void)
 			blog(LOG_ERROR, "%s: obs_module_post_load catch while launching server", obs_module_description());
 		}
 
-		if (browserGood && !GrpcPlugin::instance().connectToClient(targetListenPort))
-		{
-			browserGood = FALSE;
-			blog(LOG_ERROR, "%s: obs_module_post_load can't connect to process, GetLastError = %d", obs_module_description(), GetLastError());
-
-			// Terminates the process
-			TerminateProcess(g_browserProcessInfo.hProcess, EXIT_SUCCESS);
-			CloseHandle(g_browserProcessInfo.hProcess);
-			CloseHandle(g_browserProcessInfo.hThread);
-		}
+		// Doesn't block, calls made before the proxy is up are held until its stream attaches
+		if (browserGood)
+			GrpcPlugin::instance().connectToClient(targetListenAddress);
 	}
 
 	std::string errorMsg = "Failed to initialize plugin " + std::string(obs_module_description()) + "\nRestart the application and try again.";
@@ -195,8 +216,24 @@ void obs_module_post_load(void)
 		return;
 	}
 
-	// Streamlabs button to toggle visibility
 	QMainWindow * window = (QMainWindow *)obs_frontend_get_main_window();
+
+	// The proxy brings up cef and its links on its own time, obs carries on loading meanwhile
+	//	GrpcPlugin::stop wakes it early
+	g_proxyReadyThread = std::thread([window, errorMsg]() {
+		if (GrpcPlugin::instance().waitForProxyReady(std::chrono::seconds(30)))
+			return;
+
+		blog(LOG_ERROR, "%s: proxy process never reported ready", obs_module_description());
+
+		// Terminates the process
+		TerminateProcess(g_browserProcessInfo.hProcess, EXIT_SUCCESS);
+
+		// Shown from the Qt thread so this one is done, unload never waits on the box
+		QMetaObject::invokeMethod(window, [errorMsg]() { ::MessageBoxA(NULL, errorMsg.c_str(), "Streamlabs Error", MB_ICONERROR | MB_TOPMOST); }, Qt::QueuedConnection);
+	});
+
+	// Streamlabs button to toggle visibility
 	QAction *action = new QAction("Streamlabs", window);
 	QObject::connect(action, &QAction::triggered, [=]() {
 
@@ -211,11 +248,19 @@ void obs_module_unload(void)
 {
 	// Terminates the browser process (it shouldn't exist)
 	::TerminateProcess(g_browserProcessInfo.hProcess, EXIT_SUCCESS);
-	::CloseHandle(g_browserProcessInfo.hProcess);
-	::CloseHandle(g_browserProcessInfo.hThread);
 
 	// JS handler needs to be stopped before Grpc or crash
 	PluginJsHandler::instance().stop();
+	SceneGraph::instance().stop();
+	ObsEventChannel::instance().stop();
+	ObsReadCache::instance().stop();
 	GrpcPlugin::instance().stop();
 	WebServer::instance().stop();
+
+	// Woken by GrpcPlugin::stop, joined before the process handle it uses is closed
+	if (g_proxyReadyThread.joinable())
+		g_proxyReadyThread.join();
+
+	::CloseHandle(g_browserProcessInfo.hProcess);
+	::CloseHandle(g_browserProcessInfo.hThread);
 }